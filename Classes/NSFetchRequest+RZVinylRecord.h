@@ -47,4 +47,60 @@
                                    where:(NSPredicate* RZCNullable)predicate
                                     sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors;
 
+/**
+ *  Returns a configured fetch request based on the provided arguments.
+ *  This avoids looking up the entity by name, and is preferable when the entity description is already known.
+ *
+ *  @param entity          The entity to fetch. Must not be nil.
+ *  @param predicate       An optional predicate for the fetch.
+ *  @param sortDescriptors An optional array of sort descriptors to sort the result.
+ *
+ *  @return A configured fetch request.
+ */
++ (RZNullable instancetype)rzv_forEntityDescription:(NSEntityDescription* RZCNonnull)entity
+                                              where:(NSPredicate* RZCNullable)predicate
+                                               sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors;
+
+
+/**
+ *  Returns a configured fetch request based on the provided arguments, which prefetches the provided
+ *  relationships along with the results. Prefetching loads the destination objects of each relationship
+ *  with one extra query for the whole result, instead of firing a fault for each object when it is first accessed.
+ *
+ *  @param entityName               The name of the entity to fetch. Must not be nil.
+ *  @param context                  The context in which to fetch. Must not be nil.
+ *  @param predicate                An optional predicate for the fetch.
+ *  @param sortDescriptors          An optional array of sort descriptors to sort the result.
+ *  @param prefetchKeyPaths         An optional array of relationship key paths to prefetch.
+ *  @param returnsObjectsAsFaults   Pass NO to load the attribute values of the results with the fetch, rather than returning faults.
+ *
+ *  @return A configured fetch request.
+ */
++ (RZNullable instancetype)rzv_forEntity:(NSString* RZCNonnull)entityName
+                               inContext:(NSManagedObjectContext* RZCNonnull)context
+                                   where:(NSPredicate* RZCNullable)predicate
+                                    sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                             prefetching:(RZGeneric(NSArray, NSString *) * RZCNullable)prefetchKeyPaths
+                  returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults;
+
+/**
+ *  Returns a configured fetch request based on the provided arguments, which prefetches the provided
+ *  relationships along with the results.
+ *
+ *  @param entity                   The entity to fetch. Must not be nil.
+ *  @param predicate                An optional predicate for the fetch.
+ *  @param sortDescriptors          An optional array of sort descriptors to sort the result.
+ *  @param prefetchKeyPaths         An optional array of relationship key paths to prefetch.
+ *  @param returnsObjectsAsFaults   Pass NO to load the attribute values of the results with the fetch, rather than returning faults.
+ *
+ *  @return A configured fetch request.
+ *
+ *  @see @p +rzv_forEntity:inContext:where:sort:prefetching:returnsObjectsAsFaults:
+ */
++ (RZNullable instancetype)rzv_forEntityDescription:(NSEntityDescription* RZCNonnull)entity
+                                              where:(NSPredicate* RZCNullable)predicate
+                                               sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                                        prefetching:(RZGeneric(NSArray, NSString *) * RZCNullable)prefetchKeyPaths
+                             returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults;
+
 @end
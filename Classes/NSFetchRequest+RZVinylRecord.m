@@ -41,13 +41,24 @@
         return nil;
     }
     
-    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] init];
     NSEntityDescription *entity = [NSEntityDescription entityForName:entityName inManagedObjectContext:context];
     
     if ( !RZVAssert(entity != nil, @"Cannot find entity named %@ in context", entityName)) {
         return nil;
     }
     
+    return [self rzv_forEntityDescription:entity where:predicate sort:sortDescriptors];
+}
+
++ (instancetype)rzv_forEntityDescription:(NSEntityDescription *)entity
+                                   where:(NSPredicate *)predicate
+                                    sort:(NSArray *)sortDescriptors
+{
+    if ( !RZVParameterAssert(entity) ) {
+        return nil;
+    }
+    
+    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] init];
     [fetchRequest setEntity:entity];
     
     if ( predicate ) {
@@ -61,4 +72,38 @@
     return fetchRequest;
 }
 
+
++ (instancetype)rzv_forEntity:(NSString *)entityName
+                    inContext:(NSManagedObjectContext *)context
+                        where:(NSPredicate *)predicate
+                         sort:(NSArray *)sortDescriptors
+                  prefetching:(NSArray *)prefetchKeyPaths
+       returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+{
+    NSFetchRequest *fetchRequest = [self rzv_forEntity:entityName inContext:context where:predicate sort:sortDescriptors];
+    [fetchRequest rzv_setPrefetchKeyPaths:prefetchKeyPaths returnsObjectsAsFaults:returnsObjectsAsFaults];
+    return fetchRequest;
+}
+
++ (instancetype)rzv_forEntityDescription:(NSEntityDescription *)entity
+                                   where:(NSPredicate *)predicate
+                                    sort:(NSArray *)sortDescriptors
+                             prefetching:(NSArray *)prefetchKeyPaths
+                  returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+{
+    NSFetchRequest *fetchRequest = [self rzv_forEntityDescription:entity where:predicate sort:sortDescriptors];
+    [fetchRequest rzv_setPrefetchKeyPaths:prefetchKeyPaths returnsObjectsAsFaults:returnsObjectsAsFaults];
+    return fetchRequest;
+}
+
+#pragma mark - Private
+
+- (void)rzv_setPrefetchKeyPaths:(NSArray *)prefetchKeyPaths returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+{
+    if ( prefetchKeyPaths.count > 0 ) {
+        [self setRelationshipKeyPathsForPrefetching:prefetchKeyPaths];
+    }
+    [self setReturnsObjectsAsFaults:returnsObjectsAsFaults];
+}
+
 @end
@@ -67,4 +67,32 @@
                       sectionNameKeyPath:(NSString* RZCNullable)sectionNameKeyPath
                                cacheName:(NSString* RZCNullable)cacheName;
 
+
+/**
+ *  Returns a configured fetched results controller based on the provided arguments, which prefetches the provided
+ *  relationships along with each batch of results. Use this to avoid firing a relationship fault for every row of a list.
+ *
+ *  @param entityName               The name of the entity to fetch. Must not be nil.
+ *  @param context                  The context in which to fetch. Must not be nil.
+ *  @param predicate                An optional predicate for the fetch.
+ *  @param sortDescriptors          An optional array of sort descriptors to sort the results.
+ *  @param prefetchKeyPaths         An optional array of relationship key paths to prefetch. Pass nil to use the
+ *                                  @p +rzv_relationshipKeyPathsForPrefetching of the entity's class, or an empty array to prefetch nothing.
+ *  @param returnsObjectsAsFaults   Pass NO to load the attribute values of the results with the fetch, rather than returning faults.
+ *  @param sectionNameKeyPath       An optional keypath by which to group the results into sections.
+ *  @param cacheName                An optional cache name for the controller. Pass nil to disable caching.
+ *
+ *  @return A configured fetched results controller.
+ *
+ *  @note The other constructors prefetch the relationships returned by the entity class's @p +rzv_relationshipKeyPathsForPrefetching.
+ */
++ (RZNullable instancetype)rzv_forEntity:(NSString* RZCNonnull)entityName
+                               inContext:(NSManagedObjectContext* RZCNonnull)context
+                                   where:(NSPredicate* RZCNullable)predicate
+                                    sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                             prefetching:(RZGeneric(NSArray, NSString *) * RZCNullable)prefetchKeyPaths
+                  returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+                      sectionNameKeyPath:(NSString* RZCNullable)sectionNameKeyPath
+                               cacheName:(NSString* RZCNullable)cacheName;
+
 @end
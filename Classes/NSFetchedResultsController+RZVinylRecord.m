@@ -30,6 +30,7 @@
 #import "NSFetchedResultsController+RZVinylRecord.h"
 #import "RZVinylDefines.h"
 #import "NSFetchRequest+RZVinylRecord.h"
+#import "NSManagedObject+RZVinylRecord.h"
 
 @implementation NSFetchedResultsController (RZVinylRecord)
 
@@ -52,15 +53,47 @@
                          sort:(NSArray *)sortDescriptors
            sectionNameKeyPath:(NSString *)sectionNameKeyPath
                     cacheName:(NSString *)cacheName
+{
+    return [self rzv_forEntity:entityName
+                     inContext:context
+                         where:predicate
+                          sort:sortDescriptors
+                   prefetching:nil
+        returnsObjectsAsFaults:YES
+            sectionNameKeyPath:sectionNameKeyPath
+                     cacheName:cacheName];
+}
+
++ (instancetype)rzv_forEntity:(NSString *)entityName
+                    inContext:(NSManagedObjectContext *)context
+                        where:(NSPredicate *)predicate
+                         sort:(NSArray *)sortDescriptors
+                  prefetching:(NSArray *)prefetchKeyPaths
+       returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+           sectionNameKeyPath:(NSString *)sectionNameKeyPath
+                    cacheName:(NSString *)cacheName
 {
     if ( !RZVParameterAssert(entityName) || !RZVParameterAssert(context) ) {
         return nil;
     }
     
-    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntity:entityName
-                                                inContext:context
-                                                    where:predicate
-                                                     sort:sortDescriptors];
+    NSEntityDescription *entity = [NSEntityDescription entityForName:entityName inManagedObjectContext:context];
+    if ( !RZVAssert(entity != nil, @"Cannot find entity named %@ in context", entityName) ) {
+        return nil;
+    }
+    
+    if ( prefetchKeyPaths == nil ) {
+        Class entityClass = NSClassFromString(entity.managedObjectClassName);
+        if ( [entityClass isSubclassOfClass:[NSManagedObject class]] ) {
+            prefetchKeyPaths = [entityClass rzv_relationshipKeyPathsForPrefetching];
+        }
+    }
+    
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:entity
+                                                               where:predicate
+                                                                sort:sortDescriptors
+                                                         prefetching:prefetchKeyPaths
+                                              returnsObjectsAsFaults:returnsObjectsAsFaults];
     
     return [[NSFetchedResultsController alloc] initWithFetchRequest:fetch
                                                managedObjectContext:context
@@ -203,6 +203,183 @@
                             sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
                        inContext:(NSManagedObjectContext* RZCNonnull)context;
 
+/**
+ *  Return the results of a fetch on the main context using a predicate with optional sorting,
+ *  prefetching the provided relationships.
+ *
+ *  @param predicate                An @p NSPredicate to filter the query. Passing nil will return all objects.
+ *  @param sortDescriptors          An optional array of sort descriptors.
+ *  @param prefetchKeyPaths         An optional array of relationship key paths to prefetch. Pass nil to use
+ *                                  @p +rzv_relationshipKeyPathsForPrefetching, or an empty array to prefetch nothing.
+ *  @param returnsObjectsAsFaults   Pass NO to load the attribute values of the results with the fetch, rather than returning faults.
+ *
+ *  @return The results of the fetch.
+ *
+ *  @see @p +rzv_where:sort:prefetching:returnsObjectsAsFaults:inContext:
+ */
++ (NSArray* RZCNonnull)rzv_where:(NSPredicate* RZCNullable)predicate
+                            sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                     prefetching:(RZGeneric(NSArray, NSString *) * RZCNullable)prefetchKeyPaths
+          returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults;
+
+/**
+ *  Return the results of a fetch on the provided context using a predicate with optional sorting,
+ *  prefetching the provided relationships. The destination objects of each prefetched relationship are loaded
+ *  with one extra query for the whole result, rather than with one fault per object when the relationship is accessed.
+ *
+ *  @param predicate                An @p NSPredicate to filter the query. Passing nil will return all objects.
+ *  @param sortDescriptors          An optional array of sort descriptors.
+ *  @param prefetchKeyPaths         An optional array of relationship key paths to prefetch. Pass nil to use
+ *                                  @p +rzv_relationshipKeyPathsForPrefetching, or an empty array to prefetch nothing.
+ *  @param returnsObjectsAsFaults   Pass NO to load the attribute values of the results with the fetch, rather than returning faults.
+ *  @param context                  The managed object context on which to perform the fetch. Must not be nil.
+ *
+ *  @return The results of the fetch.
+ *
+ *  @note The other @p rzv_where and @p rzv_all methods prefetch @p +rzv_relationshipKeyPathsForPrefetching and return faults.
+ */
++ (NSArray* RZCNonnull)rzv_where:(NSPredicate* RZCNullable)predicate
+                            sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                     prefetching:(RZGeneric(NSArray, NSString *) * RZCNullable)prefetchKeyPaths
+          returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+                       inContext:(NSManagedObjectContext* RZCNonnull)context;
+
+/**
+ *  Return the values of a subset of attributes for the objects matching a fetch on the main context.
+ *
+ *  @param keys             The names of the attributes to fetch. Key paths through to-one relationships are also allowed. Must not be nil.
+ *  @param predicate        An @p NSPredicate to filter the query. Passing nil will return values for all objects.
+ *  @param sortDescriptors  An optional array of sort descriptors.
+ *
+ *  @return An array with a dictionary of values for each matching object.
+ *
+ *  @see @p +rzv_valuesForKeys:where:sort:inContext:
+ */
++ (RZVArrayOfStringDict* RZCNonnull)rzv_valuesForKeys:(RZGeneric(NSArray, NSString *) * RZCNonnull)keys
+                                                where:(NSPredicate* RZCNullable)predicate
+                                                 sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors;
+
+/**
+ *  Return the values of a subset of attributes for the objects matching a fetch on the provided context.
+ *
+ *  The values are fetched as dictionaries, so no managed objects or row snapshots are created. Dictionary
+ *  results come straight from the store, so if the context or any of its parents have unsaved changes the
+ *  matching objects are fetched instead, and the values are read from them.
+ *
+ *  @param keys             The names of the attributes to fetch. Key paths through to-one relationships are also allowed. Must not be nil.
+ *  @param predicate        An @p NSPredicate to filter the query. Passing nil will return values for all objects.
+ *  @param sortDescriptors  An optional array of sort descriptors.
+ *  @param context          The managed object context on which to perform the fetch. Must not be nil.
+ *
+ *  @return An array with a dictionary of values for each matching object.
+ *
+ *  @note As with Core Data dictionary results, keys with a nil value are omitted from the dictionaries.
+ */
++ (RZVArrayOfStringDict* RZCNonnull)rzv_valuesForKeys:(RZGeneric(NSArray, NSString *) * RZCNonnull)keys
+                                                where:(NSPredicate* RZCNullable)predicate
+                                                 sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                                            inContext:(NSManagedObjectContext* RZCNonnull)context;
+
+/**
+ *  Return the object IDs of the objects matching a fetch on the main context.
+ *
+ *  @param predicate        An @p NSPredicate to filter the query. Passing nil will return the IDs of all objects.
+ *  @param sortDescriptors  An optional array of sort descriptors.
+ *
+ *  @return The object IDs of the matching objects.
+ *
+ *  @see @p +rzv_objectIDsWhere:sort:inContext:
+ */
++ (RZGeneric(NSArray, NSManagedObjectID *) * RZCNonnull)rzv_objectIDsWhere:(NSPredicate* RZCNullable)predicate
+                                                                      sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors;
+
+/**
+ *  Return the object IDs of the objects matching a fetch on the provided context, without creating
+ *  any managed objects. Useful for handing results to another context.
+ *
+ *  @param predicate        An @p NSPredicate to filter the query. Passing nil will return the IDs of all objects.
+ *  @param sortDescriptors  An optional array of sort descriptors.
+ *  @param context          The managed object context on which to perform the fetch. Must not be nil.
+ *
+ *  @return The object IDs of the matching objects. Objects which have not been saved have temporary IDs.
+ */
++ (RZGeneric(NSArray, NSManagedObjectID *) * RZCNonnull)rzv_objectIDsWhere:(NSPredicate* RZCNullable)predicate
+                                                                      sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                                                                 inContext:(NSManagedObjectContext* RZCNonnull)context;
+
+/**
+ *  Enumerate the results of a fetch on the main context one page at a time, without holding
+ *  every object in memory.
+ *
+ *  @param predicate        An @p NSPredicate to filter the query. Passing nil will enumerate all objects.
+ *  @param sortDescriptors  An optional array of sort descriptors.
+ *  @param batchSize        The number of objects loaded per page. Must be greater than zero.
+ *  @param block            The block to call for each object. Set @p stop to YES to stop enumerating.
+ *
+ *  @see @p +rzv_enumerateWhere:sort:batchSize:inContext:usingBlock:
+ */
++ (void)rzv_enumerateWhere:(NSPredicate* RZCNullable)predicate
+                      sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                 batchSize:(NSUInteger)batchSize
+                usingBlock:(void(^ RZCNonnull)(id RZCNonnull object, BOOL* RZCNonnull stop))block;
+
+/**
+ *  Enumerate the results of a fetch on the provided context one page at a time, without holding
+ *  every object in memory. Each page is loaded with a single fetch, enumerated in its own autorelease pool,
+ *  and then turned back into faults, so memory use is bounded by the page size rather than the result count.
+ *
+ *  @param predicate        An @p NSPredicate to filter the query. Passing nil will enumerate all objects.
+ *  @param sortDescriptors  An optional array of sort descriptors.
+ *  @param batchSize        The number of objects loaded per page. Must be greater than zero.
+ *  @param context          The managed object context on which to perform the fetch. Must not be nil.
+ *  @param block            The block to call for each object. Set @p stop to YES to stop enumerating.
+ *
+ *  @note Objects with unsaved changes are not turned back into faults. Don't hold on to the objects
+ *        outside of the block, since their values are released once their page has been enumerated.
+ */
++ (void)rzv_enumerateWhere:(NSPredicate* RZCNullable)predicate
+                      sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                 batchSize:(NSUInteger)batchSize
+                 inContext:(NSManagedObjectContext* RZCNonnull)context
+                usingBlock:(void(^ RZCNonnull)(id RZCNonnull object, BOOL* RZCNonnull stop))block;
+
+
+/**
+ *  Asynchronously fetch objects on the main context using a predicate with optional sorting.
+ *
+ *  @param predicate        An @p NSPredicate to filter the query. Passing nil will return all objects.
+ *  @param sortDescriptors  An optional array of sort descriptors.
+ *  @param completion       Called on the main thread with the results, or an error if the fetch failed or was cancelled.
+ *
+ *  @return A progress object which can be used to cancel the fetch.
+ *
+ *  @see @p +rzv_asyncWhere:sort:inContext:completion:
+ */
++ (NSProgress* RZCNullable)rzv_asyncWhere:(NSPredicate* RZCNullable)predicate
+                                     sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                               completion:(void(^ RZCNonnull)(NSArray* RZCNullable results, NSError* RZCNullable error))completion;
+
+/**
+ *  Asynchronously fetch objects on the provided context using a predicate with optional sorting.
+ *
+ *  On iOS 8 and later, if every store is SQLite, the fetch runs in the persistent store coordinator with an
+ *  @p NSAsynchronousFetchRequest, and the context's queue is only used to deliver the results. For a child context,
+ *  only object IDs are fetched from the store, and the objects are then loaded in the context with a few @p IN fetches,
+ *  keeping the sort order. Objects deleted from the store in between are omitted. If the context or any of its
+ *  parents have unsaved changes, which the store can't see, the fetch is performed on the context's queue instead.
+ *
+ *  @param predicate        An @p NSPredicate to filter the query. Passing nil will return all objects.
+ *  @param sortDescriptors  An optional array of sort descriptors.
+ *  @param context          The managed object context in which to return the objects. Must not be nil.
+ *  @param completion       Called on the context's queue with the results, or an error if the fetch failed or was cancelled.
+ *
+ *  @return A progress object which can be used to cancel the fetch. A cancelled fetch completes with an
+ *          @p NSUserCancelledError in the @p NSCocoaErrorDomain.
+ */
++ (NSProgress* RZCNullable)rzv_asyncWhere:(NSPredicate* RZCNullable)predicate
+                                     sort:(RZGeneric(NSArray, NSSortDescriptor *) * RZCNullable)sortDescriptors
+                                inContext:(NSManagedObjectContext* RZCNonnull)context
+                               completion:(void(^ RZCNonnull)(NSArray* RZCNullable results, NSError* RZCNullable error))completion;
 
 /** @name Counting Objects */
 
@@ -243,6 +420,139 @@
 + (NSUInteger)rzv_countWhere:(NSPredicate* RZCNullable)predicate inContext:(NSManagedObjectContext* RZCNonnull)context;
 
 
+/** @name Aggregating Values */
+
+
+/**
+ *  Return the sum of an attribute's values over the objects matching the query in the main context.
+ *
+ *  @param keyPath      The key path of a numeric attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will aggregate over all objects.
+ *
+ *  @return The sum of the values, or zero if no objects match. Returns nil if the query failed.
+ *
+ *  @see @p +rzv_sumOf:where:inContext:
+ */
++ (NSNumber* RZCNullable)rzv_sumOf:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate;
+
+/**
+ *  Return the sum of an attribute's values over the objects matching the query in the provided context.
+ *
+ *  If every store is SQLite and neither the context nor its parents have unsaved changes, the sum is computed
+ *  by the store in a single query, without fetching or faulting in any objects. Otherwise the matching objects
+ *  are fetched and the sum is computed in memory, so that unsaved changes are taken into account.
+ *
+ *  @param keyPath      The key path of a numeric attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will aggregate over all objects.
+ *  @param context      The context in which to aggregate the values. Must not be nil.
+ *
+ *  @return The sum of the values, or zero if no objects match. Returns nil if the query failed.
+ */
++ (NSNumber* RZCNullable)rzv_sumOf:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate inContext:(NSManagedObjectContext* RZCNonnull)context;
+
+/**
+ *  Return the average of an attribute's values over the objects matching the query in the main context.
+ *
+ *  @param keyPath      The key path of a numeric attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will aggregate over all objects.
+ *
+ *  @return The average of the values, or nil if no objects match or the query failed.
+ *
+ *  @see @p +rzv_sumOf:where:inContext: for details on how aggregates are computed.
+ */
++ (NSNumber* RZCNullable)rzv_averageOf:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate;
+
+/**
+ *  Return the average of an attribute's values over the objects matching the query in the provided context.
+ *
+ *  @param keyPath      The key path of a numeric attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will aggregate over all objects.
+ *  @param context      The context in which to aggregate the values. Must not be nil.
+ *
+ *  @return The average of the values, or nil if no objects match or the query failed.
+ *
+ *  @see @p +rzv_sumOf:where:inContext: for details on how aggregates are computed.
+ */
++ (NSNumber* RZCNullable)rzv_averageOf:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate inContext:(NSManagedObjectContext* RZCNonnull)context;
+
+/**
+ *  Return the smallest of an attribute's values over the objects matching the query in the main context.
+ *
+ *  @param keyPath      The key path of a numeric or date attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will aggregate over all objects.
+ *
+ *  @return The smallest value, or nil if no objects match or the query failed.
+ *
+ *  @see @p +rzv_sumOf:where:inContext: for details on how aggregates are computed.
+ */
++ (id RZCNullable)rzv_minOf:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate;
+
+/**
+ *  Return the smallest of an attribute's values over the objects matching the query in the provided context.
+ *
+ *  @param keyPath      The key path of a numeric or date attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will aggregate over all objects.
+ *  @param context      The context in which to aggregate the values. Must not be nil.
+ *
+ *  @return The smallest value, or nil if no objects match or the query failed.
+ *
+ *  @see @p +rzv_sumOf:where:inContext: for details on how aggregates are computed.
+ */
++ (id RZCNullable)rzv_minOf:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate inContext:(NSManagedObjectContext* RZCNonnull)context;
+
+/**
+ *  Return the largest of an attribute's values over the objects matching the query in the main context.
+ *
+ *  @param keyPath      The key path of a numeric or date attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will aggregate over all objects.
+ *
+ *  @return The largest value, or nil if no objects match or the query failed.
+ *
+ *  @see @p +rzv_sumOf:where:inContext: for details on how aggregates are computed.
+ */
++ (id RZCNullable)rzv_maxOf:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate;
+
+/**
+ *  Return the largest of an attribute's values over the objects matching the query in the provided context.
+ *
+ *  @param keyPath      The key path of a numeric or date attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will aggregate over all objects.
+ *  @param context      The context in which to aggregate the values. Must not be nil.
+ *
+ *  @return The largest value, or nil if no objects match or the query failed.
+ *
+ *  @see @p +rzv_sumOf:where:inContext: for details on how aggregates are computed.
+ */
++ (id RZCNullable)rzv_maxOf:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate inContext:(NSManagedObjectContext* RZCNonnull)context;
+
+/**
+ *  Return the number of objects matching the query in the main context for each distinct value of an attribute.
+ *
+ *  @param keyPath      The key path of an attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will count all objects.
+ *
+ *  @return A dictionary of counts keyed by attribute value, or nil if the query failed.
+ *
+ *  @see @p +rzv_countGroupedBy:where:inContext:
+ */
++ (NSDictionary* RZCNullable)rzv_countGroupedBy:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate;
+
+/**
+ *  Return the number of objects matching the query in the provided context for each distinct value of an attribute.
+ *  The counts are computed by the store with a single grouped query when possible, in the same way as
+ *  @p +rzv_sumOf:where:inContext:.
+ *
+ *  @param keyPath      The key path of an attribute, optionally through to-one relationships. Must not be nil.
+ *  @param predicate    An @p NSPredicate to filter the objects. Passing nil will count all objects.
+ *  @param context      The context in which to count the objects. Must not be nil.
+ *
+ *  @return A dictionary of counts keyed by attribute value, or nil if the query failed.
+ *
+ *  @note Objects with a nil value for the key path are not counted.
+ */
++ (NSDictionary* RZCNullable)rzv_countGroupedBy:(NSString* RZCNonnull)keyPath where:(NSPredicate* RZCNullable)predicate inContext:(NSManagedObjectContext* RZCNonnull)context;
+
+
 /**  @name Deleting Objects */
 
 
@@ -285,9 +595,59 @@
  *  @param context   The context from which to delete the objects.
  *
  *  @note You must save the @p RZCoreDataStack to persist the deletion to the store.
+ *
+ *  @see @p +rzv_batchDeleteAllWhere:inContext:error: to delete without loading the objects into the context.
  */
 + (void)rzv_deleteAllWhere:(NSPredicate* RZCNullable)predicate inContext:(NSManagedObjectContext* RZCNonnull)context;
 
+/**
+ *  Delete all objects of the receiver's type matching the query, without loading them into the context.
+ *
+ *  On iOS 9 and later, if every store is SQLite and no parent of the context has unsaved changes, the objects are
+ *  removed with a single store-level batch delete. This also requires that the only relationships of the entity and
+ *  its subentities are to-one, with a nullify or no action delete rule, and a to-many or no inverse relationship.
+ *  The deletions are merged into the stack's main and top-level contexts, and the provided context.
+ *  Otherwise only the object IDs are fetched, and each object is deleted from the context as a fault,
+ *  so that relationship delete rules are applied.
+ *
+ *  @param predicate An @p NSPredicate to filter which objects to delete. Passing nil will delete all objects.
+ *  @param context   The context from which to delete the objects.
+ *  @param error     Optional pointer to an error, set if the delete fails.
+ *
+ *  @note Unsaved objects in the context are always deleted in the context. These, and objects deleted
+ *        object-by-object, are only removed from the store once the context is saved.
+ *
+ *  @return The object IDs of the deleted objects, or nil if there was an error.
+ */
++ (NSArray* RZCNullable)rzv_batchDeleteAllWhere:(NSPredicate* RZCNullable)predicate
+                                      inContext:(NSManagedObjectContext* RZCNonnull)context
+                                          error:(NSError* __autoreleasing RZCNonnull * RZCNullable)error;
+
+
+/** @name Updating Objects */
+
+/**
+ *  Set the same values on all objects of the receiver's type matching the query, without loading them into the context.
+ *
+ *  On iOS 9 and later, if every store is SQLite, every key is an attribute, and no parent of the context has unsaved
+ *  changes, the objects are updated with a single store-level batch update. The updated objects registered in the
+ *  stack's main and top-level contexts, and in the provided context, are refreshed with the new values.
+ *  Otherwise the matching objects are fetched and updated in the context.
+ *
+ *  @param predicate An @p NSPredicate to filter which objects to update. Passing nil will update all objects.
+ *  @param values    The new values keyed by attribute name. Use @p NSNull to set an attribute to nil.
+ *  @param context   The context in which to update the objects.
+ *  @param error     Optional pointer to an error, set if the update fails.
+ *
+ *  @note The batch update matches objects by their saved values and skips validation. Unsaved objects in the
+ *        context, and objects updated by the fallback, are only written to the store once the context is saved.
+ *
+ *  @return The object IDs of the updated objects, or nil if there was an error.
+ */
++ (NSArray* RZCNullable)rzv_updateAllWhere:(NSPredicate* RZCNullable)predicate
+                                 setValues:(RZVStringDictionary* RZCNonnull)values
+                                 inContext:(NSManagedObjectContext* RZCNonnull)context
+                                     error:(NSError* __autoreleasing RZCNonnull * RZCNullable)error;
 
 /** @name Subclassing */
 
@@ -318,5 +678,14 @@
  */
 + (NSPredicate* RZCNullable)rzv_stalenessPredicate;
 
+/**
+ *  Override in subclasses to return the relationship key paths that are prefetched by default
+ *  when fetching objects of this class with the @p rzv_where and @p rzv_all methods, or with a fetched
+ *  results controller created by @p NSFetchedResultsController+RZVinylRecord. Returns nil (no prefetching) by default.
+ *
+ *  @return An array of relationship key paths, such as @p @[@"songs"].
+ */
++ (RZGeneric(NSArray, NSString *) * RZCNullable)rzv_relationshipKeyPathsForPrefetching;
+
 
 @end
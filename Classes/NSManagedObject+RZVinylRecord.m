@@ -30,9 +30,17 @@
 #import "NSManagedObject+RZVinylRecord.h"
 #import "NSManagedObject+RZVinylUtils.h"
 #import "NSFetchRequest+RZVinylRecord.h"
+#import "NSManagedObject+RZVinylRecord_private.h"
+#import "NSManagedObjectContext+RZVinylSave_private.h"
 #import "RZCoreDataStack.h"
+#import "RZCoreDataStack_private.h"
+#import "RZVinylFetchTemplateCache.h"
+#import "RZVinylIdentityMap.h"
+#import "RZVinylPrimaryKeyLookup.h"
 #import "RZVinylDefines.h"
 
+static NSString* const kRZVinylRecordAggregateResultKey = @"rzv_aggregateResult";
+
 @implementation NSManagedObject (RZVinylRecord)
 
 #pragma mark - Creation
@@ -54,7 +62,11 @@
     if ( !RZVParameterAssert(context) ) {
         return nil;
     }
-    return [NSEntityDescription insertNewObjectForEntityForName:[self rzv_entityName] inManagedObjectContext:context];
+    NSEntityDescription *entity = [self rzv_entityForContext:context];
+    if ( !RZVAssert(entity != nil, @"No entity found for class %@", NSStringFromClass(self)) ) {
+        return nil;
+    }
+    return [[self alloc] initWithEntity:entity insertIntoManagedObjectContext:context];
 }
 
 + (instancetype)rzv_objectWithPrimaryKeyValue:(id)primaryValue createNew:(BOOL)createNew
@@ -80,11 +92,31 @@
         return nil;
     }
 
-    id object = [[self rzv_where:[NSPredicate predicateWithFormat:@"%K == %@", primaryKey, primaryValue] inContext:context] lastObject];
-    if ( object == nil && createNew ) {
+    NSEntityDescription *entity = [self rzv_entityForContext:context];
+    NSString *entityName = entity.name;
+    primaryValue = [self rzv_normalizedPrimaryKeyValue:primaryValue forAttribute:[entity.attributesByName objectForKey:primaryKey]];
+
+    RZVinylIdentityMap *identityMap = [RZVinylIdentityMap identityMapForContext:context];
+    id object = [identityMap objectForPrimaryKeyValue:primaryValue entityName:entityName primaryKey:primaryKey];
+    if ( object != nil ) {
+        return object;
+    }
+
+    NSFetchRequest *fetch = [[self rzv_fetchTemplateCacheForContext:context] fetchRequestForEntity:entity
+                                                                                    matchingValues:@{ primaryKey : primaryValue }
+                                                                                        fetchLimit:1];
+
+    NSError *error = nil;
+    object = [[context executeFetchRequest:fetch error:&error] lastObject];
+    if ( error ) {
+        RZVLogError(@"Error performing fetch: %@", error);
+    }
+    else if ( object == nil && createNew ) {
         object = [self rzv_newObjectInContext:context];
         [object setValue:primaryValue forKeyPath:primaryKey];
     }
+
+    [identityMap registerObject:object forPrimaryKeyValue:primaryValue entityName:entityName];
     
     return object;
 }
@@ -107,15 +139,9 @@
         return nil;
     }
     
-    NSMutableArray *predicates = [NSMutableArray array];
-    [attributes enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
-        [predicates addObject:[NSPredicate predicateWithFormat:@"%K == %@", key, value]];
-    }];
-    
-    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntity:[self rzv_entityName]
-                                                inContext:context
-                                                    where:[NSCompoundPredicate andPredicateWithSubpredicates:predicates]
-                                                     sort:nil];
+    NSFetchRequest *fetch = [[self rzv_fetchTemplateCacheForContext:context] fetchRequestForEntity:[self rzv_entityForContext:context]
+                                                                                    matchingValues:attributes
+                                                                                        fetchLimit:1];
     NSError *error = nil;
     id result = [[context executeFetchRequest:fetch error:&error] lastObject];
     if ( error ) {
@@ -182,12 +208,34 @@
 }
 
 + (NSArray *)rzv_where:(NSPredicate *)predicate sort:(NSArray *)sortDescriptors inContext:(NSManagedObjectContext *)context
+{
+    return [self rzv_where:predicate sort:sortDescriptors prefetching:nil returnsObjectsAsFaults:YES inContext:context];
+}
+
++ (NSArray *)rzv_where:(NSPredicate *)predicate sort:(NSArray *)sortDescriptors prefetching:(NSArray *)prefetchKeyPaths returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+{
+    if ( !RZVAssertMainThread() ) {
+        return [NSArray array];
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ){
+        return [NSArray array];
+    }
+    return [self rzv_where:predicate sort:sortDescriptors prefetching:prefetchKeyPaths returnsObjectsAsFaults:returnsObjectsAsFaults inContext:[stack mainManagedObjectContext]];
+}
+
++ (NSArray *)rzv_where:(NSPredicate *)predicate
+                  sort:(NSArray *)sortDescriptors
+           prefetching:(NSArray *)prefetchKeyPaths
+returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+             inContext:(NSManagedObjectContext *)context
 {
     NSError *error = nil;
-    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntity:[self rzv_entityName]
-                                                inContext:context
-                                                    where:predicate
-                                                     sort:sortDescriptors];
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:[self rzv_entityForContext:context]
+                                                               where:predicate
+                                                                sort:sortDescriptors
+                                                         prefetching:prefetchKeyPaths ?: [self rzv_relationshipKeyPathsForPrefetching]
+                                              returnsObjectsAsFaults:returnsObjectsAsFaults];
     
     NSArray *fetchedObjects = [context executeFetchRequest:fetch error:&error];
     if ( error ) {
@@ -196,6 +244,231 @@
     return fetchedObjects;
 }
 
++ (NSArray *)rzv_valuesForKeys:(NSArray *)keys where:(NSPredicate *)predicate sort:(NSArray *)sortDescriptors
+{
+    if ( !RZVAssertMainThread() ) {
+        return [NSArray array];
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ){
+        return [NSArray array];
+    }
+    return [self rzv_valuesForKeys:keys where:predicate sort:sortDescriptors inContext:[stack mainManagedObjectContext]];
+}
+
++ (NSArray *)rzv_valuesForKeys:(NSArray *)keys where:(NSPredicate *)predicate sort:(NSArray *)sortDescriptors inContext:(NSManagedObjectContext *)context
+{
+    if ( !RZVParameterAssert(keys) || !RZVParameterAssert(context) ) {
+        return [NSArray array];
+    }
+
+    NSError *error = nil;
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:[self rzv_entityForContext:context]
+                                                               where:predicate
+                                                                sort:sortDescriptors];
+
+    NSArray *values = nil;
+    if ( [self rzv_canQueryStoreDirectlyInContext:context] ) {
+        fetch.resultType = NSDictionaryResultType;
+        fetch.propertiesToFetch = keys;
+        values = [context executeFetchRequest:fetch error:&error];
+    }
+    else {
+        NSArray *objects = [context executeFetchRequest:fetch error:&error];
+        NSMutableArray *objectValues = [NSMutableArray arrayWithCapacity:objects.count];
+        for ( NSManagedObject *object in objects ) {
+            NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:keys.count];
+            for ( NSString *key in keys ) {
+                id value = [object valueForKeyPath:key];
+                if ( value != nil ) {
+                    [dictionary setObject:value forKey:key];
+                }
+            }
+            [objectValues addObject:dictionary];
+        }
+        values = objectValues;
+    }
+
+    if ( error ) {
+        RZVLogError(@"Error performing fetch: %@", error);
+    }
+    return values ?: [NSArray array];
+}
+
++ (NSArray *)rzv_objectIDsWhere:(NSPredicate *)predicate sort:(NSArray *)sortDescriptors
+{
+    if ( !RZVAssertMainThread() ) {
+        return [NSArray array];
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ){
+        return [NSArray array];
+    }
+    return [self rzv_objectIDsWhere:predicate sort:sortDescriptors inContext:[stack mainManagedObjectContext]];
+}
+
++ (NSArray *)rzv_objectIDsWhere:(NSPredicate *)predicate sort:(NSArray *)sortDescriptors inContext:(NSManagedObjectContext *)context
+{
+    NSError *error = nil;
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:[self rzv_entityForContext:context]
+                                                               where:predicate
+                                                                sort:sortDescriptors];
+
+    // Unlike dictionary results, object ID results include unsaved changes
+    fetch.resultType = NSManagedObjectIDResultType;
+
+    NSArray *objectIDs = [context executeFetchRequest:fetch error:&error];
+    if ( error ) {
+        RZVLogError(@"Error performing fetch: %@", error);
+    }
+    return objectIDs ?: [NSArray array];
+}
+
++ (void)rzv_enumerateWhere:(NSPredicate *)predicate sort:(NSArray *)sortDescriptors batchSize:(NSUInteger)batchSize usingBlock:(void (^)(id, BOOL *))block
+{
+    if ( !RZVAssertMainThread() ) {
+        return;
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ){
+        return;
+    }
+    [self rzv_enumerateWhere:predicate sort:sortDescriptors batchSize:batchSize inContext:[stack mainManagedObjectContext] usingBlock:block];
+}
+
++ (void)rzv_enumerateWhere:(NSPredicate *)predicate
+                      sort:(NSArray *)sortDescriptors
+                 batchSize:(NSUInteger)batchSize
+                 inContext:(NSManagedObjectContext *)context
+                usingBlock:(void (^)(id, BOOL *))block
+{
+    if ( !RZVParameterAssert(context) || !RZVParameterAssert(block) || !RZVAssert(batchSize > 0, @"The batch size must be greater than zero") ) {
+        return;
+    }
+
+    NSError *error = nil;
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:[self rzv_entityForContext:context]
+                                                               where:predicate
+                                                                sort:sortDescriptors];
+
+    // Only the object IDs are fetched up front, each page's rows are fetched when the page is first accessed
+    fetch.fetchBatchSize = batchSize;
+
+    NSArray *fetchedObjects = [context executeFetchRequest:fetch error:&error];
+    if ( error ) {
+        RZVLogError(@"Error performing fetch: %@", error);
+        return;
+    }
+
+    BOOL stop = NO;
+    for ( NSUInteger location = 0; location < fetchedObjects.count && !stop; location += batchSize ) {
+        @autoreleasepool {
+            NSArray *page = [fetchedObjects subarrayWithRange:NSMakeRange(location, MIN(batchSize, fetchedObjects.count - location))];
+            for ( NSManagedObject *object in page ) {
+                block(object, &stop);
+                if ( stop ) {
+                    break;
+                }
+            }
+
+            for ( NSManagedObject *object in page ) {
+                if ( !object.hasChanges ) {
+                    [context refreshObject:object mergeChanges:NO];
+                }
+            }
+        }
+    }
+}
+
++ (NSProgress *)rzv_asyncWhere:(NSPredicate *)predicate sort:(NSArray *)sortDescriptors completion:(void (^)(NSArray *, NSError *))completion
+{
+    if ( !RZVAssertMainThread() ) {
+        return nil;
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ){
+        return nil;
+    }
+    return [self rzv_asyncWhere:predicate sort:sortDescriptors inContext:[stack mainManagedObjectContext] completion:completion];
+}
+
++ (NSProgress *)rzv_asyncWhere:(NSPredicate *)predicate
+                          sort:(NSArray *)sortDescriptors
+                     inContext:(NSManagedObjectContext *)context
+                    completion:(void (^)(NSArray *, NSError *))completion
+{
+    if ( !RZVParameterAssert(context) || !RZVParameterAssert(completion) ) {
+        return nil;
+    }
+
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:[self rzv_entityForContext:context]
+                                                               where:predicate
+                                                                sort:sortDescriptors];
+    NSProgress *progress = [NSProgress progressWithTotalUnitCount:1];
+
+    void (^finish)(NSArray *, NSError *) = ^(NSArray *results, NSError *error) {
+        if ( progress.isCancelled ) {
+            results = nil;
+            error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSUserCancelledError userInfo:nil];
+        }
+        else if ( error != nil ) {
+            RZVLogError(@"Error performing fetch: %@", error);
+        }
+        completion(results, error);
+    };
+
+    [context performBlock:^{
+        if ( progress.isCancelled ) {
+            finish(nil, nil);
+            return;
+        }
+
+        NSManagedObjectContext *storeContext = [self rzv_asynchronousFetchContextForContext:context];
+        if ( storeContext == nil ) {
+            NSError *error = nil;
+            NSArray *results = [context executeFetchRequest:fetch error:&error];
+            progress.completedUnitCount = 1;
+            finish(results, error);
+            return;
+        }
+
+        if ( storeContext != context ) {
+            fetch.resultType = NSManagedObjectIDResultType;
+        }
+
+        NSAsynchronousFetchRequest *asyncFetch = [[NSAsynchronousFetchRequest alloc] initWithFetchRequest:fetch completionBlock:^(NSAsynchronousFetchResult *result) {
+            // Also keeps a temporary store context alive until the fetch completes
+            BOOL fetchesObjectIDs = ( storeContext != context );
+            NSArray *finalResult = result.finalResult;
+            NSError *error = result.operationError;
+            [context performBlock:^{
+                NSArray *results = finalResult;
+                if ( fetchesObjectIDs && results != nil ) {
+                    // Materialize the objects with chunked IN fetches, rather than firing a fault per object, keeping the sort order
+                    results = [results rzv_objectsInContext:context returnsObjectsAsFaults:NO];
+                }
+                finish(results, error);
+            }];
+        }];
+
+        [storeContext performBlock:^{
+            // The fetch's own progress becomes a child of the returned progress, so cancelling it stops the fetch
+            [progress becomeCurrentWithPendingUnitCount:1];
+            NSError *error = nil;
+            [storeContext executeRequest:asyncFetch error:&error];
+            [progress resignCurrent];
+
+            if ( error != nil ) {
+                [context performBlock:^{
+                    finish(nil, error);
+                }];
+            }
+        }];
+    }];
+
+    return progress;
+}
+
 #pragma mark - Count
 
 + (NSUInteger)rzv_count
@@ -225,10 +498,9 @@
 
 + (NSUInteger)rzv_countWhere:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context
 {
-    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntity:[self rzv_entityName]
-                                                inContext:context
-                                                    where:predicate
-                                                     sort:nil];
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:[self rzv_entityForContext:context]
+                                                               where:predicate
+                                                                sort:nil];
     
     [fetch setResultType:NSCountResultType];
     
@@ -240,6 +512,142 @@
     return count;
 }
 
+#pragma mark - Aggregate
+
++ (NSNumber *)rzv_sumOf:(NSString *)keyPath where:(NSPredicate *)predicate
+{
+    if ( !RZVAssertMainThread() ) {
+        return nil;
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ) {
+        return nil;
+    }
+    return [self rzv_sumOf:keyPath where:predicate inContext:[stack mainManagedObjectContext]];
+}
+
++ (NSNumber *)rzv_sumOf:(NSString *)keyPath where:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context
+{
+    return [self rzv_aggregate:@"sum:" ofKeyPath:keyPath where:predicate inContext:context];
+}
+
++ (NSNumber *)rzv_averageOf:(NSString *)keyPath where:(NSPredicate *)predicate
+{
+    if ( !RZVAssertMainThread() ) {
+        return nil;
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ) {
+        return nil;
+    }
+    return [self rzv_averageOf:keyPath where:predicate inContext:[stack mainManagedObjectContext]];
+}
+
++ (NSNumber *)rzv_averageOf:(NSString *)keyPath where:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context
+{
+    return [self rzv_aggregate:@"average:" ofKeyPath:keyPath where:predicate inContext:context];
+}
+
++ (id)rzv_minOf:(NSString *)keyPath where:(NSPredicate *)predicate
+{
+    if ( !RZVAssertMainThread() ) {
+        return nil;
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ) {
+        return nil;
+    }
+    return [self rzv_minOf:keyPath where:predicate inContext:[stack mainManagedObjectContext]];
+}
+
++ (id)rzv_minOf:(NSString *)keyPath where:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context
+{
+    return [self rzv_aggregate:@"min:" ofKeyPath:keyPath where:predicate inContext:context];
+}
+
++ (id)rzv_maxOf:(NSString *)keyPath where:(NSPredicate *)predicate
+{
+    if ( !RZVAssertMainThread() ) {
+        return nil;
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ) {
+        return nil;
+    }
+    return [self rzv_maxOf:keyPath where:predicate inContext:[stack mainManagedObjectContext]];
+}
+
++ (id)rzv_maxOf:(NSString *)keyPath where:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context
+{
+    return [self rzv_aggregate:@"max:" ofKeyPath:keyPath where:predicate inContext:context];
+}
+
++ (NSDictionary *)rzv_countGroupedBy:(NSString *)keyPath where:(NSPredicate *)predicate
+{
+    if ( !RZVAssertMainThread() ) {
+        return nil;
+    }
+    RZCoreDataStack *stack = [self rzv_validCoreDataStack];
+    if ( stack == nil ) {
+        return nil;
+    }
+    return [self rzv_countGroupedBy:keyPath where:predicate inContext:[stack mainManagedObjectContext]];
+}
+
++ (NSDictionary *)rzv_countGroupedBy:(NSString *)keyPath where:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context
+{
+    if ( !RZVParameterAssert(keyPath) || !RZVParameterAssert(context) ) {
+        return nil;
+    }
+
+    NSEntityDescription *entity = [self rzv_entityForContext:context];
+    NSAttributeDescription *attribute = [self rzv_attributeForKeyPath:keyPath inEntity:entity];
+    if ( !RZVAssert(attribute != nil, @"Key path \"%@\" is not an attribute of entity %@", keyPath, entity.name) ) {
+        return nil;
+    }
+
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:entity where:predicate sort:nil];
+    NSMutableDictionary *counts = [NSMutableDictionary dictionary];
+    NSError *err = nil;
+
+    if ( [self rzv_canQueryStoreDirectlyInContext:context] ) {
+        NSExpressionDescription *countDescription = [[NSExpressionDescription alloc] init];
+        countDescription.name = kRZVinylRecordAggregateResultKey;
+        countDescription.expression = [NSExpression expressionForFunction:@"count:" arguments:@[[NSExpression expressionForKeyPath:keyPath]]];
+        countDescription.expressionResultType = NSInteger64AttributeType;
+
+        fetch.resultType = NSDictionaryResultType;
+        fetch.propertiesToFetch = @[keyPath, countDescription];
+        fetch.propertiesToGroupBy = @[keyPath];
+
+        for ( NSDictionary *row in [context executeFetchRequest:fetch error:&err] ) {
+            id value = [row objectForKey:keyPath];
+            if ( value != nil ) {
+                [counts setObject:[row objectForKey:kRZVinylRecordAggregateResultKey] forKey:value];
+            }
+        }
+    }
+    else {
+        NSCountedSet *values = [NSCountedSet set];
+        for ( NSManagedObject *object in [context executeFetchRequest:fetch error:&err] ) {
+            id value = [object valueForKeyPath:keyPath];
+            if ( value != nil ) {
+                [values addObject:value];
+            }
+        }
+        for ( id value in values ) {
+            [counts setObject:@([values countForObject:value]) forKey:value];
+        }
+    }
+
+    if ( err != nil ) {
+        RZVLogError(@"Error counting objects of entity %@ grouped by %@: %@", entity.name, keyPath, err);
+        return nil;
+    }
+
+    return counts;
+}
+
 #pragma mark - Delete
 
 - (void)rzv_delete
@@ -288,6 +696,349 @@
     }];
 }
 
++ (NSArray *)rzv_batchDeleteAllWhere:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context error:(NSError *__autoreleasing *)error
+{
+    if ( !RZVParameterAssert(context) ) {
+        return nil;
+    }
+
+    NSEntityDescription *entity = [self rzv_entityForContext:context];
+    if ( !RZVAssert(entity != nil, @"No entity found for class %@", NSStringFromClass(self)) ) {
+        return nil;
+    }
+
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:entity where:predicate sort:nil];
+    NSMutableArray *deletedIDs = [NSMutableArray array];
+    NSError *deleteErr = nil;
+
+    if ( [self rzv_canBatchDeleteEntity:entity inContext:context] ) {
+        // Unsaved objects aren't in the store yet, so the batch delete can't see them
+        for ( NSManagedObject *object in [[context insertedObjects] allObjects] ) {
+            if ( [object.entity isKindOfEntity:entity] && ( predicate == nil || [predicate evaluateWithObject:object] ) ) {
+                [deletedIDs addObject:object.objectID];
+                [context deleteObject:object];
+            }
+        }
+
+        NSBatchDeleteRequest *batchDelete = [[NSBatchDeleteRequest alloc] initWithFetchRequest:fetch];
+        batchDelete.resultType = NSBatchDeleteResultTypeObjectIDs;
+
+        NSBatchDeleteResult *result = (NSBatchDeleteResult *)[context executeRequest:batchDelete error:&deleteErr];
+        NSArray *storeDeletedIDs = result.result;
+        if ( storeDeletedIDs.count > 0 ) {
+            [deletedIDs addObjectsFromArray:storeDeletedIDs];
+
+            [self rzv_mergeStoreChanges:@{ NSDeletedObjectsKey : storeDeletedIDs } intoContext:context];
+        }
+    }
+    else {
+        fetch.resultType = NSManagedObjectIDResultType;
+        NSArray *objectIDs = [context executeFetchRequest:fetch error:&deleteErr];
+        for ( NSManagedObjectID *objectID in objectIDs ) {
+            [context deleteObject:[context objectWithID:objectID]];
+        }
+        [deletedIDs addObjectsFromArray:objectIDs];
+    }
+
+    if ( deleteErr != nil ) {
+        RZVLogError(@"Error deleting objects of entity %@: %@", entity.name, deleteErr);
+        if ( error != NULL ) {
+            *error = deleteErr;
+        }
+        return nil;
+    }
+
+    return deletedIDs;
+}
+
++ (NSArray *)rzv_deleteObjectsWithIDs:(NSArray *)objectIDs inContext:(NSManagedObjectContext *)context error:(NSError *__autoreleasing *)error
+{
+    if ( !RZVParameterAssert(objectIDs) || !RZVParameterAssert(context) ) {
+        return nil;
+    }
+
+    NSEntityDescription *entity = [self rzv_entityForContext:context];
+    if ( !RZVAssert(entity != nil, @"No entity found for class %@", NSStringFromClass(self)) ) {
+        return nil;
+    }
+
+    NSMutableArray *deletedIDs = [NSMutableArray arrayWithCapacity:objectIDs.count];
+    NSError *deleteErr = nil;
+
+    // Objects that haven't been saved yet can only be deleted through the context
+    BOOL hasTemporaryIDs = NO;
+    for ( NSManagedObjectID *objectID in objectIDs ) {
+        if ( objectID.isTemporaryID ) {
+            hasTemporaryIDs = YES;
+            break;
+        }
+    }
+
+    if ( !hasTemporaryIDs && [self rzv_canBatchDeleteEntity:entity inContext:context] ) {
+        // Stay below SQLite's bound variable limit, as primary key lookups do
+        NSUInteger chunkSize = kRZVinylPrimaryKeyLookupChunkSize;
+        for ( NSUInteger location = 0; location < objectIDs.count && deleteErr == nil; location += chunkSize ) {
+            NSArray *chunk = [objectIDs subarrayWithRange:NSMakeRange(location, MIN(chunkSize, objectIDs.count - location))];
+            NSBatchDeleteRequest *batchDelete = [[NSBatchDeleteRequest alloc] initWithObjectIDs:chunk];
+            batchDelete.resultType = NSBatchDeleteResultTypeObjectIDs;
+
+            NSBatchDeleteResult *result = (NSBatchDeleteResult *)[context executeRequest:batchDelete error:&deleteErr];
+            NSArray *storeDeletedIDs = result.result;
+            if ( storeDeletedIDs.count > 0 ) {
+                [deletedIDs addObjectsFromArray:storeDeletedIDs];
+
+                [self rzv_mergeStoreChanges:@{ NSDeletedObjectsKey : storeDeletedIDs } intoContext:context];
+            }
+        }
+    }
+    else {
+        for ( NSManagedObjectID *objectID in objectIDs ) {
+            [context deleteObject:[context objectWithID:objectID]];
+        }
+        [deletedIDs addObjectsFromArray:objectIDs];
+    }
+
+    if ( deleteErr != nil ) {
+        RZVLogError(@"Error deleting objects of entity %@: %@", entity.name, deleteErr);
+        if ( error != NULL ) {
+            *error = deleteErr;
+        }
+        return nil;
+    }
+
+    return deletedIDs;
+}
+
+#pragma mark - Update
+
++ (NSArray *)rzv_updateAllWhere:(NSPredicate *)predicate setValues:(NSDictionary *)values inContext:(NSManagedObjectContext *)context error:(NSError *__autoreleasing *)error
+{
+    if ( !RZVParameterAssert(values) || !RZVParameterAssert(context) ) {
+        return nil;
+    }
+
+    NSEntityDescription *entity = [self rzv_entityForContext:context];
+    if ( !RZVAssert(entity != nil, @"No entity found for class %@", NSStringFromClass(self)) ) {
+        return nil;
+    }
+
+    NSMutableArray *updatedIDs = [NSMutableArray array];
+    NSError *updateErr = nil;
+
+    if ( [self rzv_canBatchUpdateEntity:entity values:values inContext:context] ) {
+        // Unsaved objects aren't in the store yet, so the batch update can't see them
+        for ( NSManagedObject *object in [[context insertedObjects] allObjects] ) {
+            if ( [object.entity isKindOfEntity:entity] && ( predicate == nil || [predicate evaluateWithObject:object] ) ) {
+                [object setValuesForKeysWithDictionary:values];
+                [updatedIDs addObject:object.objectID];
+            }
+        }
+
+        NSMutableDictionary *propertiesToUpdate = [NSMutableDictionary dictionaryWithCapacity:values.count];
+        [values enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+            [propertiesToUpdate setObject:[NSExpression expressionForConstantValue:( value == [NSNull null] ) ? nil : value] forKey:key];
+        }];
+
+        NSBatchUpdateRequest *batchUpdate = [[NSBatchUpdateRequest alloc] initWithEntity:entity];
+        batchUpdate.predicate = predicate;
+        batchUpdate.propertiesToUpdate = propertiesToUpdate;
+        batchUpdate.resultType = NSUpdatedObjectIDsResultType;
+
+        NSBatchUpdateResult *result = (NSBatchUpdateResult *)[context executeRequest:batchUpdate error:&updateErr];
+        NSArray *storeUpdatedIDs = result.result;
+        if ( storeUpdatedIDs.count > 0 ) {
+            [updatedIDs addObjectsFromArray:storeUpdatedIDs];
+            [self rzv_mergeStoreChanges:@{ NSUpdatedObjectsKey : storeUpdatedIDs } intoContext:context];
+        }
+    }
+    else {
+        NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:entity where:predicate sort:nil];
+        NSArray *objects = [context executeFetchRequest:fetch error:&updateErr];
+        for ( NSManagedObject *object in objects ) {
+            [object setValuesForKeysWithDictionary:values];
+            [updatedIDs addObject:object.objectID];
+        }
+    }
+
+    if ( updateErr != nil ) {
+        RZVLogError(@"Error updating objects of entity %@: %@", entity.name, updateErr);
+        if ( error != NULL ) {
+            *error = updateErr;
+        }
+        return nil;
+    }
+
+    return updatedIDs;
+}
+
+#pragma mark - Private
+
++ (id)rzv_normalizedPrimaryKeyValue:(id)primaryValue forAttribute:(NSAttributeDescription *)attribute
+{
+    if ( primaryValue == nil || attribute == nil ) {
+        return primaryValue;
+    }
+
+    switch ( attribute.attributeType ) {
+        case NSInteger16AttributeType:
+        case NSInteger32AttributeType:
+        case NSInteger64AttributeType:
+            if ( [primaryValue isKindOfClass:[NSString class]] ) {
+                NSScanner *scanner = [NSScanner scannerWithString:primaryValue];
+                long long integerValue = 0;
+                if ( [scanner scanLongLong:&integerValue] && [scanner isAtEnd] ) {
+                    return @(integerValue);
+                }
+            }
+            break;
+        case NSDoubleAttributeType:
+        case NSFloatAttributeType:
+            if ( [primaryValue isKindOfClass:[NSString class]] ) {
+                NSScanner *scanner = [NSScanner scannerWithString:primaryValue];
+                double doubleValue = 0.0;
+                if ( [scanner scanDouble:&doubleValue] && [scanner isAtEnd] ) {
+                    return @(doubleValue);
+                }
+            }
+            break;
+        case NSStringAttributeType:
+            if ( [primaryValue isKindOfClass:[NSNumber class]] ) {
+                return [primaryValue stringValue];
+            }
+            break;
+        default:
+            break;
+    }
+
+    return primaryValue;
+}
+
++ (NSDictionary *)rzv_existingObjectsByPrimaryKeyValue:(NSSet *)primaryValues
+                                             inContext:(NSManagedObjectContext *)context
+                                              keysOnly:(BOOL)keysOnly
+                                            fetchCount:(NSUInteger *)fetchCount
+                                   identityMapHitCount:(NSUInteger *)identityMapHitCount
+{
+    NSString *primaryKey = [self rzv_primaryKey];
+    if ( !RZVAssert(primaryKey != nil, @"No primary key provided for class %@. Ensure that +rzv_primaryKey is overridden and returning a valid key.", NSStringFromClass(self)) ) {
+        return [NSDictionary dictionary];
+    }
+
+    NSEntityDescription *entity = [self rzv_entityForContext:context];
+    NSString *entityName = entity.name;
+    RZVinylIdentityMap *identityMap = [RZVinylIdentityMap identityMapForContext:context];
+
+    NSMutableDictionary *existingObjsByID = [NSMutableDictionary dictionary];
+    NSMutableSet *unresolvedValues = [NSMutableSet set];
+    for ( id primaryValue in primaryValues ) {
+        if ( primaryValue == [NSNull null] ) {
+            continue;
+        }
+        NSManagedObject *object = [identityMap objectForPrimaryKeyValue:primaryValue entityName:entityName primaryKey:primaryKey];
+        if ( object != nil ) {
+            [existingObjsByID setObject:object forKey:primaryValue];
+        }
+        else {
+            [unresolvedValues addObject:primaryValue];
+        }
+    }
+
+    if ( identityMapHitCount != NULL ) {
+        *identityMapHitCount = existingObjsByID.count;
+    }
+
+    RZVinylPrimaryKeyLookup *lookup = [[RZVinylPrimaryKeyLookup alloc] initWithEntity:entity
+                                                                           primaryKey:primaryKey
+                                                                              context:context
+                                                                             keysOnly:keysOnly];
+    NSDictionary *fetchedObjsByID = [lookup objectsByPrimaryKeyValue:unresolvedValues fetchCount:fetchCount];
+    [fetchedObjsByID enumerateKeysAndObjectsUsingBlock:^(id primaryValue, NSManagedObject *object, BOOL *stop) {
+        [existingObjsByID setObject:object forKey:primaryValue];
+        [identityMap registerObject:object forPrimaryKeyValue:primaryValue entityName:entityName];
+    }];
+
+    return existingObjsByID;
+}
+
+/**
+ *  Aggregate an attribute's values with one of the @p NSExpression statistics functions ("sum:", "average:",
+ *  "min:" or "max:"). The store can only see saved values, so unsaved changes are aggregated in memory.
+ */
++ (id)rzv_aggregate:(NSString *)function ofKeyPath:(NSString *)keyPath where:(NSPredicate *)predicate inContext:(NSManagedObjectContext *)context
+{
+    if ( !RZVParameterAssert(keyPath) || !RZVParameterAssert(context) ) {
+        return nil;
+    }
+
+    NSEntityDescription *entity = [self rzv_entityForContext:context];
+    NSAttributeDescription *attribute = [self rzv_attributeForKeyPath:keyPath inEntity:entity];
+    if ( !RZVAssert(attribute != nil, @"Key path \"%@\" is not an attribute of entity %@", keyPath, entity.name) ) {
+        return nil;
+    }
+
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:entity where:predicate sort:nil];
+    BOOL isSum = [function isEqualToString:@"sum:"];
+    id result = nil;
+    NSError *err = nil;
+
+    if ( [self rzv_canQueryStoreDirectlyInContext:context] ) {
+        NSAttributeType resultType = attribute.attributeType;
+        if ( isSum && ( resultType == NSInteger16AttributeType || resultType == NSInteger32AttributeType ) ) {
+            resultType = NSInteger64AttributeType;
+        }
+        else if ( [function isEqualToString:@"average:"] && resultType != NSDecimalAttributeType ) {
+            resultType = NSDoubleAttributeType;
+        }
+
+        NSExpressionDescription *description = [[NSExpressionDescription alloc] init];
+        description.name = kRZVinylRecordAggregateResultKey;
+        description.expression = [NSExpression expressionForFunction:function arguments:@[[NSExpression expressionForKeyPath:keyPath]]];
+        description.expressionResultType = resultType;
+
+        fetch.resultType = NSDictionaryResultType;
+        fetch.propertiesToFetch = @[description];
+
+        NSDictionary *row = [[context executeFetchRequest:fetch error:&err] firstObject];
+        result = [row objectForKey:kRZVinylRecordAggregateResultKey];
+    }
+    else {
+        NSMutableArray *values = [[[context executeFetchRequest:fetch error:&err] valueForKeyPath:keyPath] mutableCopy];
+        [values removeObject:[NSNull null]];
+        if ( values.count > 0 ) {
+            result = [[NSExpression expressionForFunction:function arguments:@[[NSExpression expressionForConstantValue:values]]] expressionValueWithObject:nil context:nil];
+        }
+    }
+
+    if ( err != nil ) {
+        RZVLogError(@"Error aggregating %@ of entity %@: %@", keyPath, entity.name, err);
+        return nil;
+    }
+
+    // A sum over nothing is still a sum
+    if ( result == nil && isSum ) {
+        result = @0;
+    }
+    return result;
+}
+
+/**
+ *  The attribute at the end of a key path that only traverses to-one relationships, since those are the
+ *  only key paths that have a single value per object.
+ */
++ (NSAttributeDescription *)rzv_attributeForKeyPath:(NSString *)keyPath inEntity:(NSEntityDescription *)entity
+{
+    NSArray *keys = [keyPath componentsSeparatedByString:@"."];
+    NSEntityDescription *currentEntity = entity;
+    for ( NSUInteger i = 0; i < keys.count - 1; i++ ) {
+        NSRelationshipDescription *relationship = [currentEntity.relationshipsByName objectForKey:keys[i]];
+        if ( relationship == nil || relationship.isToMany ) {
+            return nil;
+        }
+        currentEntity = relationship.destinationEntity;
+    }
+    return [currentEntity.attributesByName objectForKey:[keys lastObject]];
+}
+
 #pragma mark - Subclassable
 
 + (NSPredicate *)rzv_stalenessPredicate
@@ -300,11 +1051,190 @@
     return nil;
 }
 
++ (NSArray *)rzv_relationshipKeyPathsForPrefetching
+{
+    return nil;
+}
+
 + (RZCoreDataStack *)rzv_coreDataStack
 {
     return [RZCoreDataStack defaultStack];
 }
 
+/**
+ *  Batch deletes need iOS 9, only work against SQLite stores, and bypass relationship delete rules,
+ *  so entities with relationships that need a delete rule applied (including those of subentities) have to
+ *  be deleted through the context. They also can't see unsaved objects in parent contexts, or unsaved
+ *  updates and deletions in the context itself.
+ */
++ (BOOL)rzv_canBatchDeleteEntity:(NSEntityDescription *)entity inContext:(NSManagedObjectContext *)context
+{
+    if ( NSClassFromString(@"NSBatchDeleteRequest") == Nil || ![self rzv_canExecuteBatchRequestsInContext:context] ||
+         [self rzv_context:context hasChangedObjectsOfEntity:entity] ) {
+        return NO;
+    }
+
+    NSMutableArray *entities = [NSMutableArray arrayWithObject:entity];
+    while ( entities.count > 0 ) {
+        NSEntityDescription *current = [entities lastObject];
+        [entities removeLastObject];
+        for ( NSRelationshipDescription *relationship in [current.relationshipsByName allValues] ) {
+            if ( ![self rzv_canBatchDeleteRelationship:relationship] ) {
+                return NO;
+            }
+        }
+        [entities addObjectsFromArray:current.subentities];
+    }
+
+    return YES;
+}
+
+/**
+ *  Batch updates can only set attributes. Like batch deletes, they need iOS 9 to merge the results, and can't
+ *  see unsaved updates and deletions in the context.
+ */
++ (BOOL)rzv_canBatchUpdateEntity:(NSEntityDescription *)entity values:(NSDictionary *)values inContext:(NSManagedObjectContext *)context
+{
+    if ( NSClassFromString(@"NSBatchUpdateRequest") == Nil || ![self rzv_canExecuteBatchRequestsInContext:context] ||
+         [self rzv_context:context hasChangedObjectsOfEntity:entity] ) {
+        return NO;
+    }
+
+    NSDictionary *attributesByName = entity.attributesByName;
+    for ( NSString *key in values ) {
+        if ( [attributesByName objectForKey:key] == nil ) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/**
+ *  The context that should execute an asynchronous fetch for the provided context: the context itself if it is
+ *  connected to the coordinator, or a new private context on the coordinator if it is a child context.
+ *  Returns nil if the fetch has to be performed synchronously on the context.
+ */
++ (NSManagedObjectContext *)rzv_asynchronousFetchContextForContext:(NSManagedObjectContext *)context
+{
+    if ( NSClassFromString(@"NSAsynchronousFetchRequest") == Nil || context.concurrencyType == NSConfinementConcurrencyType ) {
+        return nil;
+    }
+
+    if ( ![self rzv_contextHasOnlySQLiteStores:context] ) {
+        return nil;
+    }
+
+    if ( context.parentContext == nil ) {
+        return context;
+    }
+
+    // The store can't see unsaved changes, which a fetch in the child context would include
+    if ( context.hasChanges || [context rzv_parentContextsHaveChanges] ) {
+        return nil;
+    }
+
+    NSManagedObjectContext *storeContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    storeContext.persistentStoreCoordinator = context.persistentStoreCoordinator;
+    return storeContext;
+}
+
+/**
+ *  Whether requests that bypass the context can be executed against the context's stores, and their
+ *  results merged back into the stack's contexts.
+ */
++ (BOOL)rzv_canExecuteBatchRequestsInContext:(NSManagedObjectContext *)context
+{
+    return ( [NSManagedObjectContext respondsToSelector:@selector(mergeChangesFromRemoteContextSave:intoContexts:)] &&
+             [self rzv_contextHasOnlySQLiteStores:context] &&
+             ![context rzv_parentContextsHaveChanges] );
+}
+
+/**
+ *  Whether the context has unsaved updates or deletions of objects of the entity or its subentities. A request
+ *  executed in the store would not see them, and saving them afterwards could undo or conflict with the request.
+ *  Inserted objects aren't in the store at all, so batch requests handle them in the context instead.
+ */
++ (BOOL)rzv_context:(NSManagedObjectContext *)context hasChangedObjectsOfEntity:(NSEntityDescription *)entity
+{
+    if ( !context.hasChanges ) {
+        return NO;
+    }
+
+    for ( NSSet *changedObjects in @[context.updatedObjects, context.deletedObjects] ) {
+        for ( NSManagedObject *object in changedObjects ) {
+            if ( [object.entity isKindOfEntity:entity] ) {
+                return YES;
+            }
+        }
+    }
+    return NO;
+}
+
+/**
+ *  Requests that run in the store, rather than in memory, are only supported by SQLite stores.
+ */
++ (BOOL)rzv_contextHasOnlySQLiteStores:(NSManagedObjectContext *)context
+{
+    NSArray *stores = context.persistentStoreCoordinator.persistentStores;
+    if ( stores.count == 0 ) {
+        return NO;
+    }
+    for ( NSPersistentStore *store in stores ) {
+        if ( ![store.type isEqualToString:NSSQLiteStoreType] ) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/**
+ *  Dictionary results and aggregates computed by the store don't include unsaved changes,
+ *  and need a store that can run them in SQL.
+ */
++ (BOOL)rzv_canQueryStoreDirectlyInContext:(NSManagedObjectContext *)context
+{
+    return ( [self rzv_contextHasOnlySQLiteStores:context] && !context.hasChanges && ![context rzv_parentContextsHaveChanges] );
+}
+
+/**
+ *  The stack's template cache if the context belongs to the stack's model, otherwise the context's own.
+ */
++ (RZVinylFetchTemplateCache *)rzv_fetchTemplateCacheForContext:(NSManagedObjectContext *)context
+{
+    RZCoreDataStack *stack = [[context userInfo] objectForKey:kRZCoreDataStackParentStackKey] ?: [self rzv_coreDataStack];
+    if ( stack != nil && stack.managedObjectModel == context.persistentStoreCoordinator.managedObjectModel ) {
+        return stack.fetchTemplateCache;
+    }
+    return [RZVinylFetchTemplateCache templateCacheForContext:context];
+}
+
+/**
+ *  Merge object IDs changed directly in the store into the stack's contexts and the provided context.
+ */
++ (void)rzv_mergeStoreChanges:(NSDictionary *)changes intoContext:(NSManagedObjectContext *)context
+{
+    RZCoreDataStack *stack = [[context userInfo] objectForKey:kRZCoreDataStackParentStackKey] ?: [self rzv_coreDataStack];
+    if ( stack != nil ) {
+        [stack mergeStoreChanges:changes intoContext:context];
+    }
+    else {
+        [NSManagedObjectContext mergeChangesFromRemoteContextSave:changes intoContexts:@[context]];
+    }
+}
+
+/**
+ *  A to-one relationship is stored in the object's own row, so deleting the row leaves nothing behind as long
+ *  as the relationship has no rule to apply and the destination doesn't store a reference back to it.
+ */
++ (BOOL)rzv_canBatchDeleteRelationship:(NSRelationshipDescription *)relationship
+{
+    if ( relationship.isToMany || ( relationship.deleteRule != NSNullifyDeleteRule && relationship.deleteRule != NSNoActionDeleteRule ) ) {
+        return NO;
+    }
+    NSRelationshipDescription *inverse = relationship.inverseRelationship;
+    return ( inverse == nil || inverse.isToMany );
+}
+
 + (RZCoreDataStack *)rzv_validCoreDataStack
 {
     RZCoreDataStack *stack = [self rzv_coreDataStack];
@@ -29,4 +29,46 @@
  */
 + (NSString* RZCNonnull)rzv_entityName;
 
+/**
+ *  The Core Data entity represented by this class, from the model of the class's @p RZCoreDataStack.
+ *
+ *  @return The entity description.
+ */
++ (NSEntityDescription* RZCNonnull)rzv_entity;
+
+@end
+
+@interface NSArray (RZVinylUtils)
+
+/**
+ *  Get the same objects as the receiver's in another managed object context, loading their data with
+ *  a single fetch for each entity rather than one round trip per object.
+ *
+ *  @param context The context from which to get the objects. Must not be nil.
+ *
+ *  @return The objects that exist in the context, in the same order as the receiver.
+ *
+ *  @see @p -rzv_objectsInContext:returnsObjectsAsFaults:
+ */
+- (RZGeneric(NSArray, NSManagedObject *) * RZCNonnull)rzv_objectsInContext:(NSManagedObjectContext* RZCNonnull)context;
+
+/**
+ *  Get the same objects as the receiver's in another managed object context. This is the batch equivalent of
+ *  @p -rzv_objectInContext:. Any unsaved objects get permanent IDs with one request per source context, and
+ *  the destination objects are resolved with a single @p SELF @p IN fetch for each entity, or not fetched at all
+ *  if faults are requested.
+ *
+ *  @param context                  The context from which to get the objects. Must not be nil.
+ *  @param returnsObjectsAsFaults   Pass YES to return faults without accessing the store, if the data is not needed yet.
+ *
+ *  @return The objects that exist in the context, in the same order as the receiver. Objects that don't exist in the context,
+ *          such as objects which have not been saved, are omitted unless @p returnsObjectsAsFaults is YES, in which case
+ *          firing their faults will throw an exception.
+ *
+ *  @note The receiver may contain managed objects or managed object IDs. Unsaved objects must be accessed on their own
+ *        context's queue to obtain their permanent IDs.
+ */
+- (RZGeneric(NSArray, NSManagedObject *) * RZCNonnull)rzv_objectsInContext:(NSManagedObjectContext* RZCNonnull)context
+                                                    returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults;
+
 @end
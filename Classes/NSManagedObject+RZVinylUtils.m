@@ -7,7 +7,9 @@
 
 #import "NSManagedObject+RZVinylUtils.h"
 #import "NSManagedObject+RZVinylRecord_private.h"
+#import "NSFetchRequest+RZVinylRecord.h"
 #import "RZCoreDataStack.h"
+#import "RZVinylPrimaryKeyLookup.h"
 #import "RZVinylDefines.h"
 
 @implementation NSManagedObject (RZVinylUtils)
@@ -47,21 +49,135 @@
 }
 
 + (NSString *)rzv_entityName
+{
+    return [[self rzv_entity] name];
+}
+
++ (NSEntityDescription *)rzv_entity
 {
     RZCoreDataStack *stack = [self rzv_validCoreDataStack];
     if ( stack == nil ){
         return nil;
     }
-    NSString *className = NSStringFromClass(self);
-    for ( NSEntityDescription *entity in stack.managedObjectModel.entities ) {
-        if ( [entity.managedObjectClassName isEqualToString:className] ) {
-            return entity.name;
-        }
-    }
-    return nil;
+    return [stack entityForClass:self];
 }
 
 
 #pragma mark - Private
 
++ (NSEntityDescription *)rzv_entityForContext:(NSManagedObjectContext *)context
+{
+    NSEntityDescription *entity = [self rzv_entity];
+    NSManagedObjectModel *contextModel = context.persistentStoreCoordinator.managedObjectModel;
+    if ( entity != nil && contextModel != nil && entity.managedObjectModel != contextModel ) {
+        // The context belongs to a different stack than the class, resolve the entity by name in its model
+        entity = [[contextModel entitiesByName] objectForKey:entity.name];
+    }
+    return entity;
+}
+
+@end
+
+@implementation NSArray (RZVinylUtils)
+
+- (NSArray *)rzv_objectsInContext:(NSManagedObjectContext *)context
+{
+    return [self rzv_objectsInContext:context returnsObjectsAsFaults:NO];
+}
+
+- (NSArray *)rzv_objectsInContext:(NSManagedObjectContext *)context returnsObjectsAsFaults:(BOOL)returnsObjectsAsFaults
+{
+    if ( !RZVParameterAssert(context) ) {
+        return [NSArray array];
+    }
+
+    // Obtain permanent IDs for unsaved objects with one request per source context
+    NSMapTable *temporaryObjectsByContext = [NSMapTable strongToStrongObjectsMapTable];
+    for ( id object in self ) {
+        if ( [object isKindOfClass:[NSManagedObject class]] && [object managedObjectContext] != context && [[object objectID] isTemporaryID] ) {
+            NSManagedObjectContext *objectContext = [object managedObjectContext];
+            if ( objectContext == nil ) {
+                RZVLogError(@"Cannot get object %@ from other context if it has not been inserted yet.", object);
+                continue;
+            }
+            NSMutableArray *temporaryObjects = [temporaryObjectsByContext objectForKey:objectContext];
+            if ( temporaryObjects == nil ) {
+                temporaryObjects = [NSMutableArray array];
+                [temporaryObjectsByContext setObject:temporaryObjects forKey:objectContext];
+            }
+            [temporaryObjects addObject:object];
+        }
+    }
+    for ( NSManagedObjectContext *objectContext in temporaryObjectsByContext ) {
+        NSError *permanentObjErr = nil;
+        if ( ![objectContext obtainPermanentIDsForObjects:[temporaryObjectsByContext objectForKey:objectContext] error:&permanentObjErr] ) {
+            RZVLogError(@"Error getting permanent object IDs: %@", permanentObjErr);
+        }
+    }
+
+    NSMutableArray *objectIDs = [NSMutableArray arrayWithCapacity:self.count];
+    for ( id object in self ) {
+        if ( [object isKindOfClass:[NSManagedObjectID class]] ) {
+            [objectIDs addObject:object];
+        }
+        else if ( [object managedObjectContext] == context || ![[object objectID] isTemporaryID] ) {
+            [objectIDs addObject:[object objectID]];
+        }
+    }
+
+    if ( returnsObjectsAsFaults ) {
+        NSMutableArray *faults = [NSMutableArray arrayWithCapacity:objectIDs.count];
+        for ( NSManagedObjectID *objectID in objectIDs ) {
+            [faults addObject:[context objectWithID:objectID]];
+        }
+        return faults;
+    }
+
+    // Fetch every object that isn't already loaded in the context, with one IN fetch per entity
+    NSMutableDictionary *missingIDsByEntityName = [NSMutableDictionary dictionary];
+    for ( NSManagedObjectID *objectID in objectIDs ) {
+        NSManagedObject *registered = [context objectRegisteredForID:objectID];
+        if ( registered == nil || registered.isFault ) {
+            NSMutableArray *missingIDs = [missingIDsByEntityName objectForKey:objectID.entity.name];
+            if ( missingIDs == nil ) {
+                missingIDs = [NSMutableArray array];
+                [missingIDsByEntityName setObject:missingIDs forKey:objectID.entity.name];
+            }
+            [missingIDs addObject:objectID];
+        }
+    }
+
+    // Stay below SQLite's bound variable limit, as primary key lookups do
+    NSUInteger chunkSize = kRZVinylPrimaryKeyLookupChunkSize;
+    NSMutableSet *fetchedIDs = [NSMutableSet set];
+    for ( NSString *entityName in missingIDsByEntityName ) {
+        NSArray *missingIDs = [missingIDsByEntityName objectForKey:entityName];
+        NSEntityDescription *entity = [[missingIDs firstObject] entity];
+        for ( NSUInteger location = 0; location < missingIDs.count; location += chunkSize ) {
+            NSArray *chunk = [missingIDs subarrayWithRange:NSMakeRange(location, MIN(chunkSize, missingIDs.count - location))];
+            NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:entity
+                                                                       where:[NSPredicate predicateWithFormat:@"SELF IN %@", chunk]
+                                                                        sort:nil
+                                                                 prefetching:nil
+                                                      returnsObjectsAsFaults:NO];
+
+            NSError *fetchErr = nil;
+            NSArray *fetched = [context executeFetchRequest:fetch error:&fetchErr];
+            if ( fetchErr != nil ) {
+                RZVLogError(@"Error getting objects from other context: %@", fetchErr);
+            }
+            [fetchedIDs addObjectsFromArray:[fetched valueForKey:@"objectID"]];
+        }
+    }
+
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:objectIDs.count];
+    for ( NSManagedObjectID *objectID in objectIDs ) {
+        NSManagedObject *object = [context objectRegisteredForID:objectID];
+        if ( object != nil && ( !object.isFault || [fetchedIDs containsObject:objectID] ) ) {
+            [objects addObject:object];
+        }
+    }
+    return objects;
+}
+
 @end
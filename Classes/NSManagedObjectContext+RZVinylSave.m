@@ -28,8 +28,10 @@
 //
 
 #import "NSManagedObjectContext+RZVinylSave.h"
+#import "NSManagedObjectContext+RZVinylSave_private.h"
 #import "RZVinylDefines.h"
 #import "RZCoreDataStack_private.h"
+#import "RZVinylContextChangeTracker.h"
 #import "RZVinylDefines.h"
 
 
@@ -50,6 +52,17 @@ static void rzv_performSaveCompletionAsync(RZVinylSaveCompletion completion, NSE
     return [stack hasOptionsSet:RZCoreDataStackOptionsLogOnUnchangedSave];
 }
 
+- (BOOL)rzv_parentContextsHaveChanges
+{
+    // Never wait on a parent's queue here, since the parent may already be waiting on this context
+    for ( NSManagedObjectContext *parent = self.parentContext; parent != nil; parent = parent.parentContext ) {
+        if ( [RZVinylContextChangeTracker contextHasChanges:parent] ) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
 - (void)rzv_saveToStoreWithCompletion:(void (^)(NSError *))completion
 {
     if ( !RZVAssert(self.concurrencyType != NSConfinementConcurrencyType, @"RZVinylSave methods cannot be used on contexts with thread confinement.") ) {
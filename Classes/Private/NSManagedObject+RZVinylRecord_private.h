@@ -41,4 +41,44 @@
  */
 + (RZCoreDataStack *)rzv_validCoreDataStack;
 
+/**
+ *  The entity represented by this class, from the model used by the provided context.
+ *  Uses the class's stack lookup table, without a name lookup unless the context belongs to another model.
+ */
++ (NSEntityDescription *)rzv_entityForContext:(NSManagedObjectContext *)context;
+
+/**
+ *  The primary key value converted to the type of the primary key attribute, so that equal keys from
+ *  different sources (e.g. @"42" and @42) are also equal as dictionary keys and in predicates.
+ *  Strings are converted to numbers for integer and floating point attributes, and numbers to strings for
+ *  string attributes. Values that can't be converted are returned unchanged.
+ */
++ (id)rzv_normalizedPrimaryKeyValue:(id)primaryValue forAttribute:(NSAttributeDescription *)attribute;
+
+/**
+ *  Resolve existing objects for a set of primary key values, keyed by primary key value.
+ *  Objects already known to the context's identity map are returned without a fetch, and
+ *  the remaining values are resolved by RZVinylPrimaryKeyLookup, in as few fetches as the key set allows.
+ *
+ *  @param keysOnly            Fetch only the primary key and object ID of each row, and return objects that are not
+ *                             already registered in the context as faults. Ignored if a parent context has unsaved changes.
+ *  @param fetchCount          Optional pointer filled in with the number of fetches performed.
+ *  @param identityMapHitCount Optional pointer filled in with the number of objects found in the identity map.
+ */
++ (NSDictionary *)rzv_existingObjectsByPrimaryKeyValue:(NSSet *)primaryValues
+                                             inContext:(NSManagedObjectContext *)context
+                                              keysOnly:(BOOL)keysOnly
+                                            fetchCount:(NSUInteger *)fetchCount
+                                   identityMapHitCount:(NSUInteger *)identityMapHitCount;
+
+/**
+ *  Delete the objects with the provided IDs, which must belong to the receiver's entity.
+ *  When possible, saved objects are deleted directly in the store with batch deletes by object ID, in chunks that stay
+ *  below SQLite's bound variable limit, and the deletions are merged into the context and the stack's contexts.
+ *  Otherwise they are deleted from the context, and the deletions must be saved.
+ *
+ *  @return The IDs of the deleted objects, or nil if there was an error.
+ */
++ (NSArray *)rzv_deleteObjectsWithIDs:(NSArray *)objectIDs inContext:(NSManagedObjectContext *)context error:(NSError *__autoreleasing *)error;
+
 @end
\ No newline at end of file
@@ -0,0 +1,46 @@
+//
+//  NSManagedObjectContext+RZVinylSave_private.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+/**
+ *  This header contains private method prototypes for NSManagedObjectContext+RZVinylSave
+ *  These are NOT intended for public usage.
+ */
+@import CoreData;
+
+@interface NSManagedObjectContext ()
+
+/**
+ *  Whether any ancestor of this context has unsaved changes. Requests that go straight to the store,
+ *  such as dictionary fetches and batch deletes, can't see those changes.
+ *
+ *  @note This never blocks on the ancestors' queues. It uses the state recorded by @p RZVinylContextChangeTracker,
+ *        and an ancestor that wasn't created by an @p RZCoreDataStack is assumed to have changes.
+ */
+- (BOOL)rzv_parentContextsHaveChanges;
+
+@end
@@ -8,9 +8,36 @@
 
 #import "RZCoreDataStack.h"
 
+@class RZVinylFetchTemplateCache;
+
 @interface RZCoreDataStack()
 
+/**
+ *  Fetch request and predicate templates for lookups by attribute value, shared by all of the stack's contexts.
+ */
+@property (nonatomic, strong, readonly) RZVinylFetchTemplateCache *fetchTemplateCache;
+
 - (BOOL)hasOptionsSet:(RZCoreDataStackOptions)options;
 
+/**
+ *  A new private queue context attached directly to the persistent store coordinator,
+ *  so that several of them can import and save in parallel without going through the top level context.
+ *  Saves are merged into the top level context and the main context.
+ *
+ *  @note Call @p -unregisterSaveNotificationsForContext: when finished with the context.
+ */
+- (NSManagedObjectContext *)independentBackgroundManagedObjectContext;
+
+- (void)unregisterSaveNotificationsForContext:(NSManagedObjectContext *)context;
+
+/**
+ *  Merges changes made directly in the persistent store (for instance, by a batch request) into the
+ *  top level context, the main context, and the provided context and its ancestors.
+ *
+ *  @param changes A dictionary of arrays of object IDs keyed by @p NSInsertedObjectsKey, @p NSUpdatedObjectsKey or @p NSDeletedObjectsKey.
+ *  @param context An optional context outside of the stack's own contexts that should also be updated.
+ */
+- (void)mergeStoreChanges:(NSDictionary *)changes intoContext:(NSManagedObjectContext *)context;
+
 @end
 
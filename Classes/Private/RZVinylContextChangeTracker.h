@@ -0,0 +1,52 @@
+//
+//  RZVinylContextChangeTracker.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@import CoreData;
+
+/**
+ *  Records whether a context has unsaved changes, so that other queues can check without blocking on the context.
+ *  The state is updated on the context's queue whenever it posts @p NSManagedObjectContextObjectsDidChangeNotification
+ *  or @p NSManagedObjectContextDidSaveNotification, and when one of its child contexts saves into it.
+ *  FOR INTERNAL LIBRARY USE ONLY
+ *
+ *  @note Only contexts created by an @p RZCoreDataStack are tracked.
+ */
+@interface RZVinylContextChangeTracker : NSObject
+
+/**
+ *  Start tracking the context. Must be called before the context is used on another queue.
+ */
++ (void)trackContext:(NSManagedObjectContext *)context;
+
+/**
+ *  Whether the context had unsaved changes when it last processed them. Safe to call from any queue.
+ *  Returns YES for contexts that are not tracked, since their state is unknown.
+ */
++ (BOOL)contextHasChanges:(NSManagedObjectContext *)context;
+
+@end
@@ -0,0 +1,136 @@
+//
+//  RZVinylContextChangeTracker.m
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylContextChangeTracker.h"
+
+@interface RZVinylContextChangeTracker ()
+
+@property (nonatomic, weak) NSManagedObjectContext *context;
+
+// Written on the context's queue, read from any queue
+@property (atomic, assign) BOOL hasChanges;
+
+@end
+
+@implementation RZVinylContextChangeTracker
+
++ (void)trackContext:(NSManagedObjectContext *)context
+{
+    if ( context == nil ) {
+        return;
+    }
+
+    NSMapTable *trackers = [self trackersByContext];
+    @synchronized ( trackers ) {
+        if ( [trackers objectForKey:context] == nil ) {
+            [trackers setObject:[[RZVinylContextChangeTracker alloc] initWithContext:context] forKey:context];
+        }
+    }
+}
+
++ (BOOL)contextHasChanges:(NSManagedObjectContext *)context
+{
+    RZVinylContextChangeTracker *tracker = [self trackerForContext:context];
+    return ( tracker != nil ) ? tracker.hasChanges : YES;
+}
+
+- (instancetype)initWithContext:(NSManagedObjectContext *)context
+{
+    self = [super init];
+    if ( self ) {
+        _context = context;
+        _hasChanges = context.hasChanges;
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(handleObjectsDidChange:) name:NSManagedObjectContextObjectsDidChangeNotification object:context];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Private
+
+// weak context -> tracker
++ (NSMapTable *)trackersByContext
+{
+    static NSMapTable *s_trackersByContext = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        s_trackersByContext = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                        valueOptions:NSPointerFunctionsStrongMemory
+                                                            capacity:0];
+
+        // Saves are observed for every context, since a child that isn't tracked can still save into a tracked parent
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(handleContextDidSave:) name:NSManagedObjectContextDidSaveNotification object:nil];
+    });
+    return s_trackersByContext;
+}
+
++ (RZVinylContextChangeTracker *)trackerForContext:(NSManagedObjectContext *)context
+{
+    if ( context == nil ) {
+        return nil;
+    }
+
+    NSMapTable *trackers = [self trackersByContext];
+    @synchronized ( trackers ) {
+        return [trackers objectForKey:context];
+    }
+}
+
+#pragma mark - Notifications
+
++ (void)handleContextDidSave:(NSNotification *)notification
+{
+    // Posted on the saving context's queue
+    NSManagedObjectContext *context = [notification object];
+    [self trackerForContext:context].hasChanges = context.hasChanges;
+
+    // The saved changes are now unsaved changes of the parent, which may not have processed them yet
+    NSDictionary *userInfo = [notification userInfo];
+    BOOL savedChanges = ( [[userInfo objectForKey:NSInsertedObjectsKey] count] > 0 ||
+                          [[userInfo objectForKey:NSUpdatedObjectsKey] count] > 0 ||
+                          [[userInfo objectForKey:NSDeletedObjectsKey] count] > 0 );
+    if ( savedChanges ) {
+        [self trackerForContext:context.parentContext].hasChanges = YES;
+    }
+}
+
+- (void)handleObjectsDidChange:(NSNotification *)notification
+{
+    // Posted on the context's queue, so its state can be read directly
+    NSManagedObjectContext *context = self.context;
+    if ( context != nil && [notification object] == context ) {
+        self.hasChanges = context.hasChanges;
+    }
+}
+
+@end
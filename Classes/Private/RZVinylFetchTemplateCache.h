@@ -0,0 +1,54 @@
+//
+//  RZVinylFetchTemplateCache.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@import CoreData;
+
+/**
+ *  Prebuilt fetch requests for looking up objects by attribute values. Each entity has a request template
+ *  with the entity already resolved, and each set of attribute keys has a predicate template with
+ *  substitution variables for the values, so lookups never parse a predicate format string.
+ *  FOR INTERNAL LIBRARY USE ONLY
+ *
+ *  @note The templates are immutable, so a cache can be shared by all contexts of a stack.
+ */
+@interface RZVinylFetchTemplateCache : NSObject
+
+/**
+ *  The template cache of a context that doesn't belong to a stack, created on first access.
+ */
++ (RZVinylFetchTemplateCache *)templateCacheForContext:(NSManagedObjectContext *)context;
+
+/**
+ *  A new fetch request for the objects of the entity whose attributes are equal to all of the values.
+ *
+ *  @param values       The values to match, keyed by attribute key path. @p NSNull matches nil.
+ *  @param fetchLimit   The fetch limit of the request, or zero for no limit.
+ */
+- (NSFetchRequest *)fetchRequestForEntity:(NSEntityDescription *)entity matchingValues:(NSDictionary *)values fetchLimit:(NSUInteger)fetchLimit;
+
+@end
@@ -0,0 +1,132 @@
+//
+//  RZVinylFetchTemplateCache.m
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylFetchTemplateCache.h"
+#import "NSFetchRequest+RZVinylRecord.h"
+
+static NSString* const kRZVinylFetchTemplateCacheKey = @"RZVinylFetchTemplateCache";
+
+@interface RZVinylFetchTemplateCache ()
+
+// entity name -> fetch request without a predicate
+@property (nonatomic, strong) NSMutableDictionary *requestTemplatesByEntityName;
+
+// comma separated sorted keys -> predicate with one substitution variable per key
+@property (nonatomic, strong) NSMutableDictionary *predicateTemplatesByKeys;
+
+@end
+
+@implementation RZVinylFetchTemplateCache
+
++ (RZVinylFetchTemplateCache *)templateCacheForContext:(NSManagedObjectContext *)context
+{
+    if ( context == nil ) {
+        return nil;
+    }
+    RZVinylFetchTemplateCache *cache = [[context userInfo] objectForKey:kRZVinylFetchTemplateCacheKey];
+    if ( cache == nil ) {
+        cache = [[RZVinylFetchTemplateCache alloc] init];
+        [[context userInfo] setObject:cache forKey:kRZVinylFetchTemplateCacheKey];
+    }
+    return cache;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if ( self ) {
+        _requestTemplatesByEntityName = [NSMutableDictionary dictionary];
+        _predicateTemplatesByKeys = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - Public
+
+- (NSFetchRequest *)fetchRequestForEntity:(NSEntityDescription *)entity matchingValues:(NSDictionary *)values fetchLimit:(NSUInteger)fetchLimit
+{
+    NSArray *keys = ( values.count == 1 ) ? [values allKeys] : [[values allKeys] sortedArrayUsingSelector:@selector(compare:)];
+
+    NSMutableDictionary *variables = [NSMutableDictionary dictionaryWithCapacity:keys.count];
+    [keys enumerateObjectsUsingBlock:^(NSString *key, NSUInteger idx, BOOL *stop) {
+        [variables setObject:[values objectForKey:key] forKey:[self variableNameAtIndex:idx]];
+    }];
+
+    NSFetchRequest *fetch = [[self requestTemplateForEntity:entity] copy];
+    fetch.predicate = [[self predicateTemplateForKeys:keys] predicateWithSubstitutionVariables:variables];
+    fetch.fetchLimit = fetchLimit;
+    return fetch;
+}
+
+#pragma mark - Private
+
+- (NSFetchRequest *)requestTemplateForEntity:(NSEntityDescription *)entity
+{
+    @synchronized ( self ) {
+        NSFetchRequest *template = [self.requestTemplatesByEntityName objectForKey:entity.name];
+        if ( template == nil ) {
+            template = [NSFetchRequest rzv_forEntityDescription:entity where:nil sort:nil];
+            [self.requestTemplatesByEntityName setObject:template forKey:entity.name];
+        }
+        return template;
+    }
+}
+
+- (NSPredicate *)predicateTemplateForKeys:(NSArray *)keys
+{
+    NSString *cacheKey = ( keys.count == 1 ) ? [keys firstObject] : [keys componentsJoinedByString:@","];
+
+    @synchronized ( self ) {
+        NSPredicate *template = [self.predicateTemplatesByKeys objectForKey:cacheKey];
+        if ( template == nil ) {
+            NSMutableArray *predicates = [NSMutableArray arrayWithCapacity:keys.count];
+            [keys enumerateObjectsUsingBlock:^(NSString *key, NSUInteger idx, BOOL *stop) {
+                [predicates addObject:[NSComparisonPredicate predicateWithLeftExpression:[NSExpression expressionForKeyPath:key]
+                                                                         rightExpression:[NSExpression expressionForVariable:[self variableNameAtIndex:idx]]
+                                                                                modifier:NSDirectPredicateModifier
+                                                                                    type:NSEqualToPredicateOperatorType
+                                                                                 options:0]];
+            }];
+            template = ( predicates.count == 1 ) ? [predicates firstObject] : [NSCompoundPredicate andPredicateWithSubpredicates:predicates];
+            [self.predicateTemplatesByKeys setObject:template forKey:cacheKey];
+        }
+        return template;
+    }
+}
+
+- (NSString *)variableNameAtIndex:(NSUInteger)idx
+{
+    static NSArray *s_variableNames = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        s_variableNames = @[@"v0", @"v1", @"v2", @"v3", @"v4", @"v5", @"v6", @"v7"];
+    });
+    return ( idx < s_variableNames.count ) ? s_variableNames[idx] : [NSString stringWithFormat:@"v%lu", (unsigned long)idx];
+}
+
+@end
@@ -0,0 +1,59 @@
+//
+//  RZVinylIdentityMap.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@import CoreData;
+
+/**
+ *  Per-context map of (entity, primary key value) to managed object, used to skip
+ *  find-or-create fetches for objects the context already knows about.
+ *  FOR INTERNAL LIBRARY USE ONLY
+ *
+ *  @note Like the context it belongs to, the map must only be used on the context's queue.
+ */
+@interface RZVinylIdentityMap : NSObject
+
+/**
+ *  The identity map of the provided context, created on first access.
+ */
++ (RZVinylIdentityMap *)identityMapForContext:(NSManagedObjectContext *)context;
+
+/**
+ *  Return the registered object for the primary key value, or nil if there is none or the
+ *  registered object is no longer valid in the context (deleted, reset, or re-keyed). Registered objects that
+ *  have been turned into faults are resolved with @p existingObjectWithID:error: rather than refetched,
+ *  and dropped if their row no longer exists.
+ */
+- (NSManagedObject *)objectForPrimaryKeyValue:(id)primaryValue entityName:(NSString *)entityName primaryKey:(NSString *)primaryKey;
+
+- (void)registerObject:(NSManagedObject *)object forPrimaryKeyValue:(id)primaryValue entityName:(NSString *)entityName;
+
+- (void)removeObject:(NSManagedObject *)object;
+
+- (void)removeAllObjects;
+
+@end
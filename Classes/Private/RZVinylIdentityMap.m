@@ -0,0 +1,166 @@
+//
+//  RZVinylIdentityMap.m
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylIdentityMap.h"
+
+static NSString* const kRZVinylIdentityMapKey = @"RZVinylIdentityMap";
+
+@interface RZVinylIdentityMap ()
+
+@property (nonatomic, weak) NSManagedObjectContext *context;
+
+// entity name -> (primary key value -> weak object)
+@property (nonatomic, strong) NSMutableDictionary *objectsByEntityName;
+
+// weak object -> @[entity name, primary key value], used to unregister deleted objects
+@property (nonatomic, strong) NSMapTable *keysByObject;
+
+@end
+
+@implementation RZVinylIdentityMap
+
++ (RZVinylIdentityMap *)identityMapForContext:(NSManagedObjectContext *)context
+{
+    if ( context == nil ) {
+        return nil;
+    }
+    RZVinylIdentityMap *identityMap = [[context userInfo] objectForKey:kRZVinylIdentityMapKey];
+    if ( identityMap == nil ) {
+        identityMap = [[RZVinylIdentityMap alloc] initWithContext:context];
+        [[context userInfo] setObject:identityMap forKey:kRZVinylIdentityMapKey];
+    }
+    return identityMap;
+}
+
+- (instancetype)initWithContext:(NSManagedObjectContext *)context
+{
+    self = [super init];
+    if ( self ) {
+        _context = context;
+        _objectsByEntityName = [NSMutableDictionary dictionary];
+        _keysByObject = [NSMapTable weakToStrongObjectsMapTable];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(handleObjectsDidChange:) name:NSManagedObjectContextObjectsDidChangeNotification object:context];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(handleObjectsDidChange:) name:NSManagedObjectContextDidSaveNotification object:context];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - Public
+
+- (NSManagedObject *)objectForPrimaryKeyValue:(id)primaryValue entityName:(NSString *)entityName primaryKey:(NSString *)primaryKey
+{
+    if ( primaryValue == nil || entityName == nil ) {
+        return nil;
+    }
+
+    NSMapTable *objectsByPrimaryValue = [self.objectsByEntityName objectForKey:entityName];
+    NSManagedObject *object = [objectsByPrimaryValue objectForKey:primaryValue];
+    if ( object == nil ) {
+        return nil;
+    }
+
+    BOOL valid = ( object.managedObjectContext == self.context && !object.isDeleted );
+
+    // The row of a fault may have been deleted by another context or a batch delete that wasn't merged.
+    // Resolving it from the row cache or store is cheaper than the fetch a miss falls back on.
+    if ( valid && object.isFault ) {
+        NSError *err = nil;
+        valid = ( [self.context existingObjectWithID:object.objectID error:&err] == object );
+    }
+
+    if ( valid && primaryKey != nil ) {
+        valid = [[object valueForKey:primaryKey] isEqual:primaryValue];
+    }
+
+    if ( !valid ) {
+        [objectsByPrimaryValue removeObjectForKey:primaryValue];
+        [self.keysByObject removeObjectForKey:object];
+        return nil;
+    }
+
+    return object;
+}
+
+- (void)registerObject:(NSManagedObject *)object forPrimaryKeyValue:(id)primaryValue entityName:(NSString *)entityName
+{
+    if ( object == nil || primaryValue == nil || entityName == nil ) {
+        return;
+    }
+
+    NSMapTable *objectsByPrimaryValue = [self.objectsByEntityName objectForKey:entityName];
+    if ( objectsByPrimaryValue == nil ) {
+        objectsByPrimaryValue = [NSMapTable strongToWeakObjectsMapTable];
+        [self.objectsByEntityName setObject:objectsByPrimaryValue forKey:entityName];
+    }
+    [objectsByPrimaryValue setObject:object forKey:primaryValue];
+    [self.keysByObject setObject:@[entityName, primaryValue] forKey:object];
+}
+
+- (void)removeObject:(NSManagedObject *)object
+{
+    NSArray *key = [self.keysByObject objectForKey:object];
+    if ( key != nil ) {
+        NSMapTable *objectsByPrimaryValue = [self.objectsByEntityName objectForKey:key[0]];
+        if ( [objectsByPrimaryValue objectForKey:key[1]] == object ) {
+            [objectsByPrimaryValue removeObjectForKey:key[1]];
+        }
+        [self.keysByObject removeObjectForKey:object];
+    }
+}
+
+- (void)removeAllObjects
+{
+    [self.objectsByEntityName removeAllObjects];
+    [self.keysByObject removeAllObjects];
+}
+
+#pragma mark - Notifications
+
+- (void)handleObjectsDidChange:(NSNotification *)notification
+{
+    NSDictionary *userInfo = [notification userInfo];
+    if ( [userInfo objectForKey:NSInvalidatedAllObjectsKey] != nil ) {
+        [self removeAllObjects];
+        return;
+    }
+
+    for ( NSManagedObject *object in [userInfo objectForKey:NSDeletedObjectsKey] ) {
+        [self removeObject:object];
+    }
+    for ( NSManagedObject *object in [userInfo objectForKey:NSInvalidatedObjectsKey] ) {
+        [self removeObject:object];
+    }
+}
+
+@end
@@ -0,0 +1,77 @@
+//
+//  RZVinylPrimaryKeyLookup.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@import CoreData;
+
+/**
+ *  The maximum number of keys in a single @p IN predicate, below SQLite's bound variable limit.
+ */
+OBJC_EXTERN const NSUInteger kRZVinylPrimaryKeyLookupChunkSize;
+
+/**
+ *  The number of keys at which a range scan is considered.
+ */
+OBJC_EXTERN const NSUInteger kRZVinylPrimaryKeyLookupRangeScanThreshold;
+
+/**
+ *  Resolves the existing objects of an entity for a set of primary key values.
+ *  Small key sets are fetched with @p IN predicates, split into chunks that stay below SQLite's bound
+ *  variable limit. In keys-only lookups, large sets of numeric keys that cover most of their range are resolved
+ *  by scanning the range for keys and object IDs instead, which avoids building and binding huge predicates.
+ *  FOR INTERNAL LIBRARY USE ONLY
+ */
+@interface RZVinylPrimaryKeyLookup : NSObject
+
+/**
+ *  @param keysOnly Fetch only the primary key and object ID of each row, returning objects that are not already
+ *                  registered in the context as faults. Ignored if a parent context has unsaved changes.
+ */
+- (instancetype)initWithEntity:(NSEntityDescription *)entity
+                    primaryKey:(NSString *)primaryKey
+                       context:(NSManagedObjectContext *)context
+                      keysOnly:(BOOL)keysOnly;
+
+/**
+ *  Initializer overriding @p kRZVinylPrimaryKeyLookupChunkSize and @p kRZVinylPrimaryKeyLookupRangeScanThreshold.
+ *  Only exists so tests can compare the lookup strategies.
+ */
+- (instancetype)initWithEntity:(NSEntityDescription *)entity
+                    primaryKey:(NSString *)primaryKey
+                       context:(NSManagedObjectContext *)context
+                      keysOnly:(BOOL)keysOnly
+                     chunkSize:(NSUInteger)chunkSize
+            rangeScanThreshold:(NSUInteger)rangeScanThreshold;
+
+/**
+ *  The existing objects for the primary key values, keyed by primary key value.
+ *
+ *  @param fetchCount Optional pointer filled in with the number of store queries performed.
+ */
+- (NSDictionary *)objectsByPrimaryKeyValue:(NSSet *)primaryValues fetchCount:(NSUInteger *)fetchCount;
+
+@end
@@ -0,0 +1,245 @@
+//
+//  RZVinylPrimaryKeyLookup.m
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylPrimaryKeyLookup.h"
+#import "NSFetchRequest+RZVinylRecord.h"
+#import "NSManagedObjectContext+RZVinylSave_private.h"
+#import "RZVinylDefines.h"
+
+static NSString* const kRZVinylObjectIDKey = @"objectID";
+
+// A range scan is only used if it reads at most this many rows per key being looked up
+static const NSUInteger kRZVinylRangeScanMaxRowsPerKey = 2;
+
+const NSUInteger kRZVinylPrimaryKeyLookupChunkSize = 500;
+const NSUInteger kRZVinylPrimaryKeyLookupRangeScanThreshold = 5000;
+
+@interface RZVinylPrimaryKeyLookup ()
+
+@property (nonatomic, strong) NSEntityDescription *entity;
+@property (nonatomic, copy)   NSString *primaryKey;
+@property (nonatomic, strong) NSManagedObjectContext *context;
+@property (nonatomic, assign) BOOL keysOnly;
+@property (nonatomic, assign) NSUInteger chunkSize;
+@property (nonatomic, assign) NSUInteger rangeScanThreshold;
+
+@end
+
+@implementation RZVinylPrimaryKeyLookup
+
+- (instancetype)initWithEntity:(NSEntityDescription *)entity
+                    primaryKey:(NSString *)primaryKey
+                       context:(NSManagedObjectContext *)context
+                      keysOnly:(BOOL)keysOnly
+{
+    return [self initWithEntity:entity
+                     primaryKey:primaryKey
+                        context:context
+                       keysOnly:keysOnly
+                      chunkSize:kRZVinylPrimaryKeyLookupChunkSize
+             rangeScanThreshold:kRZVinylPrimaryKeyLookupRangeScanThreshold];
+}
+
+- (instancetype)initWithEntity:(NSEntityDescription *)entity
+                    primaryKey:(NSString *)primaryKey
+                       context:(NSManagedObjectContext *)context
+                      keysOnly:(BOOL)keysOnly
+                     chunkSize:(NSUInteger)chunkSize
+            rangeScanThreshold:(NSUInteger)rangeScanThreshold
+{
+    self = [super init];
+    if ( self ) {
+        _entity = entity;
+        _primaryKey = [primaryKey copy];
+        _context = context;
+        _keysOnly = keysOnly;
+        _chunkSize = MAX(chunkSize, 1);
+        _rangeScanThreshold = rangeScanThreshold;
+    }
+    return self;
+}
+
+- (NSDictionary *)objectsByPrimaryKeyValue:(NSSet *)primaryValues fetchCount:(NSUInteger *)fetchCount
+{
+    NSMutableDictionary *objectsByPrimaryValue = [NSMutableDictionary dictionary];
+    NSUInteger fetches = 0;
+
+    if ( primaryValues.count > 0 ) {
+        if ( self.keysOnly && [self.context rzv_parentContextsHaveChanges] ) {
+            self.keysOnly = NO;
+        }
+
+        NSPredicate *rangePredicate = [self rangePredicateForValues:primaryValues];
+        NSUInteger rangeCount = NSNotFound;
+        if ( rangePredicate != nil ) {
+            rangeCount = [self countWhere:rangePredicate];
+            fetches++;
+        }
+
+        if ( rangeCount != NSNotFound && rangeCount <= primaryValues.count * kRZVinylRangeScanMaxRowsPerKey ) {
+            [self fetchObjectsWhere:rangePredicate matchingValues:primaryValues intoDictionary:objectsByPrimaryValue];
+            fetches++;
+        }
+        else {
+            NSArray *values = [primaryValues allObjects];
+            for ( NSUInteger location = 0; location < values.count; location += self.chunkSize ) {
+                NSRange range = NSMakeRange(location, MIN(self.chunkSize, values.count - location));
+                NSArray *chunk = [values subarrayWithRange:range];
+                NSPredicate *chunkPredicate = [NSPredicate predicateWithFormat:@"%K in %@", self.primaryKey, chunk];
+                [self fetchObjectsWhere:chunkPredicate matchingValues:nil intoDictionary:objectsByPrimaryValue];
+                fetches++;
+            }
+        }
+
+        if ( self.keysOnly ) {
+            [self addPendingObjectsMatchingValues:primaryValues intoDictionary:objectsByPrimaryValue];
+        }
+    }
+
+    if ( fetchCount != NULL ) {
+        *fetchCount = fetches;
+    }
+    return objectsByPrimaryValue;
+}
+
+#pragma mark - Private
+
+/**
+ *  A predicate covering the range of the values, if they are numbers and there are enough of them
+ *  that a range scan might be cheaper than chunked IN predicates. Only keys-only lookups scan ranges,
+ *  so rows in the range that aren't being looked up are never loaded as objects.
+ */
+- (NSPredicate *)rangePredicateForValues:(NSSet *)primaryValues
+{
+    if ( !self.keysOnly || primaryValues.count < self.rangeScanThreshold ) {
+        return nil;
+    }
+
+    NSNumber *minValue = nil;
+    NSNumber *maxValue = nil;
+    for ( id value in primaryValues ) {
+        // Strings are compared with the store's collation, which NSString comparison doesn't match
+        if ( ![value isKindOfClass:[NSNumber class]] ) {
+            return nil;
+        }
+        if ( minValue == nil || [value compare:minValue] == NSOrderedAscending ) {
+            minValue = value;
+        }
+        if ( maxValue == nil || [value compare:maxValue] == NSOrderedDescending ) {
+            maxValue = value;
+        }
+    }
+
+    return [NSPredicate predicateWithFormat:@"%K >= %@ AND %K <= %@", self.primaryKey, minValue, self.primaryKey, maxValue];
+}
+
+- (NSUInteger)countWhere:(NSPredicate *)predicate
+{
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:self.entity where:predicate sort:nil];
+
+    NSError *err = nil;
+    NSUInteger count = [self.context countForFetchRequest:fetch error:&err];
+    if ( err ) {
+        RZVLogError(@"Error counting objects for entity %@: %@", self.entity.name, err);
+        return NSNotFound;
+    }
+    return count;
+}
+
+/**
+ *  Fetch the objects matching the predicate. If @p values is provided, only objects whose
+ *  primary key value is in the set are added to the dictionary.
+ */
+- (void)fetchObjectsWhere:(NSPredicate *)predicate matchingValues:(NSSet *)values intoDictionary:(NSMutableDictionary *)objectsByPrimaryValue
+{
+    NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:self.entity where:predicate sort:nil];
+
+    if ( self.keysOnly ) {
+        NSExpressionDescription *objectIDDesc = [[NSExpressionDescription alloc] init];
+        objectIDDesc.name = kRZVinylObjectIDKey;
+        objectIDDesc.expression = [NSExpression expressionForEvaluatedObject];
+        objectIDDesc.expressionResultType = NSObjectIDAttributeType;
+
+        fetch.resultType = NSDictionaryResultType;
+        fetch.propertiesToFetch = @[self.primaryKey, objectIDDesc];
+
+        // Dictionary results can't include pending changes, they are reconciled separately
+        fetch.includesPendingChanges = NO;
+    }
+
+    NSError *err = nil;
+    NSArray *results = [self.context executeFetchRequest:fetch error:&err];
+    if ( err ) {
+        RZVLogError(@"Error fetching existing objects for entity %@: %@", self.entity.name, err);
+        return;
+    }
+
+    for ( id result in results ) {
+        NSManagedObject *object = nil;
+        id primaryValue = nil;
+
+        if ( self.keysOnly ) {
+            primaryValue = [result objectForKey:self.primaryKey];
+            NSManagedObjectID *objectID = [result objectForKey:kRZVinylObjectIDKey];
+            if ( primaryValue == nil || objectID == nil ) {
+                continue;
+            }
+
+            // The stored key is stale if the object has been deleted or re-keyed in this context
+            object = [self.context objectWithID:objectID];
+            if ( object.isDeleted || ( !object.isFault && ![[object valueForKey:self.primaryKey] isEqual:primaryValue] ) ) {
+                continue;
+            }
+        }
+        else {
+            object = result;
+            primaryValue = [object valueForKey:self.primaryKey];
+        }
+
+        if ( primaryValue != nil && ( values == nil || [values containsObject:primaryValue] ) ) {
+            [objectsByPrimaryValue setObject:object forKey:primaryValue];
+        }
+    }
+}
+
+- (void)addPendingObjectsMatchingValues:(NSSet *)values intoDictionary:(NSMutableDictionary *)objectsByPrimaryValue
+{
+    NSMutableSet *pendingObjects = [[self.context insertedObjects] mutableCopy];
+    [pendingObjects unionSet:[self.context updatedObjects]];
+    for ( NSManagedObject *object in pendingObjects ) {
+        if ( ![object.entity isKindOfEntity:self.entity] ) {
+            continue;
+        }
+        id primaryValue = [object valueForKey:self.primaryKey];
+        if ( primaryValue != nil && [values containsObject:primaryValue] ) {
+            [objectsByPrimaryValue setObject:object forKey:primaryValue];
+        }
+    }
+}
+
+@end
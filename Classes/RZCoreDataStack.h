@@ -70,10 +70,23 @@ typedef NS_OPTIONS(NSUInteger, RZCoreDataStackOptions)
     /**
      *  Pass this option to log when the API attempts to save an un-changed context.
      */
-    RZCoreDataStackOptionsLogOnUnchangedSave = (1 << 5)
+    RZCoreDataStackOptionsLogOnUnchangedSave = (1 << 5),
+
+    /**
+     *  Pass this option to give every context created by the stack the @p NSMergeByPropertyObjectTrumpMergePolicy,
+     *  so that conflicts, including uniqueness constraint conflicts, are resolved in favor of the changes being saved.
+     *  @see @p RZVinylImportOptionsUpsertUsingUniquenessConstraints
+     */
+    RZCoreDataStackOptionsMergeByPropertyObjectTrump = (1 << 6)
 
 };
 
+/**
+ *  Posted on the main thread by a stack created with one of the asynchronous initializers, once its
+ *  persistent store has been loaded. The notification's object is the stack.
+ */
+OBJC_EXTERN NSString* const RZCoreDataStackDidBecomeReadyNotification;
+
 /**
  *  An efficient wrapper for a basic application-level Core Data stack.
  *  Makes use of M. Zarra's private writer pattern for efficient disk writes.
@@ -178,6 +191,62 @@ typedef NS_OPTIONS(NSUInteger, RZCoreDataStackOptions)
               persistentStoreCoordinator:(NSPersistentStoreCoordinator* RZCNullable)psc
                                  options:(RZCoreDataStackOptions)options;
 
+/**
+ *  Return a new data stack initialized with the provided data model name and persistent store type,
+ *  which loads its persistent store asynchronously.
+ *
+ *  The model, coordinator and contexts are created before this returns, but adding the store to the coordinator,
+ *  including any migration, happens on a background queue, so the time this takes on the calling thread doesn't
+ *  grow with the size of the database. Until the store is loaded, work on the main context and its descendants
+ *  waits for the store, and blocks passed to @p -performBlockUsingBackgroundContext:completion: are queued.
+ *
+ *  @param modelName            The name of the Core Data Model. Pass nil to infer default value from application name.
+ *  @param modelConfiguration   The name of a configuration from the model to use for this stack.
+ *  @param storeType            The type of persistent store to use. Pass nil to default to sqlite store.
+ *  @param storeURL             The URL of the persistent store's database file. If nil, defaults to a .sqlite file with
+ *                              the same name as the model, located in the @p Library/ directory.
+ *  @param psc                  An existing persistent store coordinator to use in this stack. Pass nil to create a new one.
+ *  @param options              Additional options for the stack.
+ *  @param completion           An optional block called on the main thread once the store has been loaded, or with an error
+ *                              if it could not be loaded. @p RZCoreDataStackDidBecomeReadyNotification is also posted on success.
+ *
+ *  @note Fetching on the main context before the stack is ready blocks the main thread until the store has been loaded.
+ *        With @p RZCoreDataStackOptionsDisableTopLevelContext, the main context can't wait for the store and must not be
+ *        used until the stack is ready.
+ *
+ *  @return A new data stack instance, or nil if the model could not be loaded.
+ */
+- (RZNullable instancetype)initWithModelName:(NSString* RZCNullable)modelName
+                               configuration:(NSString* RZCNullable)modelConfiguration
+                                   storeType:(NSString* RZCNullable)storeType
+                                    storeURL:(NSURL* RZCNullable)storeURL
+                  persistentStoreCoordinator:(NSPersistentStoreCoordinator* RZCNullable)psc
+                                     options:(RZCoreDataStackOptions)options
+                                  completion:(void(^ RZCNullable)(NSError* RZCNullable err))completion;
+
+/**
+ *  Return a new data stack initialized with a preexisting data model, which loads its persistent store asynchronously.
+ *
+ *  @param model        A configured data model. Must not be nil.
+ *  @param storeType    The type of persistent store to use. Pass nil to default to sqlite store.
+ *  @param storeURL     The URL of the persistent store's database file. If nil, defaults to a .sqlite file with
+ *                      the same name as the model, located in the @p Library/ directory.
+ *  @param psc          An existing persistent store coordinator to use in this stack. Pass nil to create a new one.
+ *  @param options      Additional options for the stack.
+ *  @param completion   An optional block called on the main thread once the store has been loaded, or with an error
+ *                      if it could not be loaded.
+ *
+ *  @return A new data stack instance.
+ *
+ *  @see @p -initWithModelName:configuration:storeType:storeURL:persistentStoreCoordinator:options:completion:
+ */
+- (RZNullable instancetype)initWithModel:(NSManagedObjectModel* RZCNonnull)model
+                               storeType:(NSString* RZCNullable)storeType
+                                storeURL:(NSURL* RZCNullable)storeURL
+              persistentStoreCoordinator:(NSPersistentStoreCoordinator* RZCNullable)psc
+                                 options:(RZCoreDataStackOptions)options
+                              completion:(void(^ RZCNullable)(NSError* RZCNullable err))completion;
+
 
 /**
  *  The main queue's managed object context for this Core Data stack.
@@ -198,6 +267,33 @@ typedef NS_OPTIONS(NSUInteger, RZCoreDataStackOptions)
  */
 @property (strong, nonatomic, readonly, RZNonnull) NSPersistentStoreCoordinator *persistentStoreCoordinator;
 
+/**
+ *  Whether the persistent store has been loaded. Stacks created with a synchronous initializer are always ready.
+ *  Updated on the main thread, just before @p RZCoreDataStackDidBecomeReadyNotification is posted.
+ */
+@property (assign, nonatomic, readonly, getter=isReady) BOOL ready;
+
+/**
+ *  Return the entity description for a managed object class in this stack's model.
+ *  The lookup table is built once when the stack is created.
+ *
+ *  @param moClass The managed object class. Must not be nil.
+ *
+ *  @return The entity whose managed object class is @p moClass, or nil if there is none.
+ *          If several entities use the class, the first one in the model is returned.
+ */
+- (NSEntityDescription* RZCNullable)entityForClass:(Class RZCNonnull)moClass;
+
+/**
+ *  Return the managed object class for an entity in this stack's model.
+ *  The lookup table is built once when the stack is created.
+ *
+ *  @param entityName The name of the entity. Must not be nil.
+ *
+ *  @return The managed object class for the entity, or nil if the entity or its class cannot be found.
+ */
+- (Class RZCNullable)classForEntityName:(NSString* RZCNonnull)entityName;
+
 /**
  *  Asynchronously perform a database operation on a temporary background managed object context.
  *  The context will be saved when the operation is finished, and all changes merged into the main context.
@@ -266,11 +362,14 @@ typedef NS_OPTIONS(NSUInteger, RZCoreDataStackOptions)
  *  Staleness for each entity type is determined by the predicate returned by 
  *  @p rzv_stalenessPredicate in an @p NSManagedObject subclass.
  *
- *  @param completion Optional completion block.
+ *  @param completion Optional completion block, passed the error of the first failed delete, or of the save.
  *
  *  @note   Calling this method will save to the persistent store, so any other unsaved
  *          changes in the main managed object context will also be saved.
  *
+ *  @note   Stale objects are deleted with @p +rzv_batchDeleteAllWhere:inContext:error:, so where possible they
+ *          are removed directly from the store without being loaded into memory.
+ *
  *  @warning This may invalidate existing managed object instances if the objects they represent
  *           are deleted. Subscribe to @p NSManagedObjectContextObjectsDidChange and check for object
  *           deletion in the main context.
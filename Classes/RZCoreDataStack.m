@@ -29,10 +29,14 @@
 @import UIKit.UIApplication;
 
 #import "RZCoreDataStack.h"
+#import "RZCoreDataStack_private.h"
 #import "NSManagedObject+RZVinylRecord.h"
 #import "NSManagedObjectContext+RZVinylSave.h"
+#import "RZVinylFetchTemplateCache.h"
+#import "RZVinylContextChangeTracker.h"
 #import "RZVinylDefines.h"
-#import <libkern/OSAtomic.h>
+
+NSString* const RZCoreDataStackDidBecomeReadyNotification = @"RZCoreDataStackDidBecomeReadyNotification";
 
 static RZCoreDataStack *s_defaultStack = nil;
 
@@ -50,9 +54,13 @@ static RZCoreDataStack *s_defaultStack = nil;
 @property (nonatomic, copy) NSURL    *storeURL;
 @property (nonatomic, strong) dispatch_queue_t backgroundContextQueue;
 @property (nonatomic, assign) RZCoreDataStackOptions options;
+@property (nonatomic, assign, readwrite, getter=isReady) BOOL ready;
 
 @property (nonatomic, readonly, strong) NSDictionary *entityClassNamesToStalenessPredicates;
 
+@property (nonatomic, strong) NSDictionary *entitiesByClassName;
+@property (nonatomic, strong) NSDictionary *classesByEntityName;
+
 @property (nonatomic, strong) NSHashTable *registeredFetchedResultsControllers;
 
 @end
@@ -108,6 +116,43 @@ static RZCoreDataStack *s_defaultStack = nil;
                          storeURL:(NSURL *)storeURL
        persistentStoreCoordinator:(NSPersistentStoreCoordinator *)psc
                           options:(RZCoreDataStackOptions)options
+{
+    return [self initWithModelName:modelName
+                     configuration:modelConfiguration
+                         storeType:storeType
+                          storeURL:storeURL
+        persistentStoreCoordinator:psc
+                           options:options
+                    asynchronously:NO
+                        completion:nil];
+}
+
+- (instancetype)initWithModelName:(NSString *)modelName
+                    configuration:(NSString *)modelConfiguration
+                        storeType:(NSString *)storeType
+                         storeURL:(NSURL *)storeURL
+       persistentStoreCoordinator:(NSPersistentStoreCoordinator *)psc
+                          options:(RZCoreDataStackOptions)options
+                       completion:(void (^)(NSError *))completion
+{
+    return [self initWithModelName:modelName
+                     configuration:modelConfiguration
+                         storeType:storeType
+                          storeURL:storeURL
+        persistentStoreCoordinator:psc
+                           options:options
+                    asynchronously:YES
+                        completion:completion];
+}
+
+- (instancetype)initWithModelName:(NSString *)modelName
+                    configuration:(NSString *)modelConfiguration
+                        storeType:(NSString *)storeType
+                         storeURL:(NSURL *)storeURL
+       persistentStoreCoordinator:(NSPersistentStoreCoordinator *)psc
+                          options:(RZCoreDataStackOptions)options
+                   asynchronously:(BOOL)asynchronously
+                       completion:(void (^)(NSError *))completion
 {
     self = [super init];
     if ( self ) {
@@ -121,8 +166,10 @@ static RZCoreDataStack *s_defaultStack = nil;
         _backgroundContextQueue     = dispatch_queue_create("com.rzvinyl.backgroundContextQueue", DISPATCH_QUEUE_SERIAL);
 
         _registeredFetchedResultsControllers = [NSHashTable weakObjectsHashTable];
+        _fetchTemplateCache         = [[RZVinylFetchTemplateCache alloc] init];
 
-        if ( ![self buildStack] ) {
+        BOOL built = asynchronously ? [self buildStackAsynchronouslyWithCompletion:completion] : [self buildStack];
+        if ( !built ) {
             return nil;
         }
         
@@ -136,6 +183,39 @@ static RZCoreDataStack *s_defaultStack = nil;
                      storeURL:(NSURL *)storeURL
    persistentStoreCoordinator:(NSPersistentStoreCoordinator *)psc
                       options:(RZCoreDataStackOptions)options
+{
+    return [self initWithModel:model
+                     storeType:storeType
+                      storeURL:storeURL
+    persistentStoreCoordinator:psc
+                       options:options
+                asynchronously:NO
+                    completion:nil];
+}
+
+- (instancetype)initWithModel:(NSManagedObjectModel *)model
+                    storeType:(NSString *)storeType
+                     storeURL:(NSURL *)storeURL
+   persistentStoreCoordinator:(NSPersistentStoreCoordinator *)psc
+                      options:(RZCoreDataStackOptions)options
+                   completion:(void (^)(NSError *))completion
+{
+    return [self initWithModel:model
+                     storeType:storeType
+                      storeURL:storeURL
+    persistentStoreCoordinator:psc
+                       options:options
+                asynchronously:YES
+                    completion:completion];
+}
+
+- (instancetype)initWithModel:(NSManagedObjectModel *)model
+                    storeType:(NSString *)storeType
+                     storeURL:(NSURL *)storeURL
+   persistentStoreCoordinator:(NSPersistentStoreCoordinator *)psc
+                      options:(RZCoreDataStackOptions)options
+               asynchronously:(BOOL)asynchronously
+                   completion:(void (^)(NSError *))completion
 {
     if ( !RZVParameterAssert(model) ) {
         return nil;
@@ -151,8 +231,10 @@ static RZCoreDataStack *s_defaultStack = nil;
         
         _backgroundContextQueue     = dispatch_queue_create("com.rzvinyl.backgroundContextQueue", DISPATCH_QUEUE_SERIAL);
         _registeredFetchedResultsControllers = [NSHashTable weakObjectsHashTable];
+        _fetchTemplateCache         = [[RZVinylFetchTemplateCache alloc] init];
 
-        if ( ![self buildStack] ) {
+        BOOL built = asynchronously ? [self buildStackAsynchronouslyWithCompletion:completion] : [self buildStack];
+        if ( !built ) {
             return nil;
         }
         
@@ -201,7 +283,9 @@ static RZCoreDataStack *s_defaultStack = nil;
     else {
         bgContext.persistentStoreCoordinator = self.persistentStoreCoordinator;
     }
+    [self configureMergePolicyForContext:bgContext];
     [self registerSaveNotificationsForContext:bgContext];
+    [RZVinylContextChangeTracker trackContext:bgContext];
     return bgContext;
 }
 
@@ -210,9 +294,27 @@ static RZCoreDataStack *s_defaultStack = nil;
     NSManagedObjectContext *tempContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
     [[tempContext userInfo] setObject:self forKey:kRZCoreDataStackParentStackKey];
     tempContext.parentContext = self.mainManagedObjectContext;
+    [self configureMergePolicyForContext:tempContext];
+    [RZVinylContextChangeTracker trackContext:tempContext];
     return tempContext;
 }
 
+- (NSEntityDescription *)entityForClass:(Class)moClass
+{
+    if ( !RZVParameterAssert(moClass) ) {
+        return nil;
+    }
+    return [self.entitiesByClassName objectForKey:NSStringFromClass(moClass)];
+}
+
+- (Class)classForEntityName:(NSString *)entityName
+{
+    if ( !RZVParameterAssert(entityName) ) {
+        return Nil;
+    }
+    return [self.classesByEntityName objectForKey:entityName];
+}
+
 - (void)ensureContextNotificationsForFetchedResultsController:(NSFetchedResultsController *)frc
 {
     if ( RZVAssert(frc.managedObjectContext == self.mainManagedObjectContext,
@@ -223,13 +325,18 @@ static RZCoreDataStack *s_defaultStack = nil;
 
 - (void)purgeStaleObjectsWithCompletion:(void (^)(NSError *))completion
 {
+    __block NSError *purgeErr = nil;
     [self performBlockUsingBackgroundContext:^(NSManagedObjectContext *context) {
         
         [self.entityClassNamesToStalenessPredicates enumerateKeysAndObjectsUsingBlock:^(NSString *className, NSPredicate *predicate, BOOL *stop) {
             
             Class moClass = NSClassFromString(className);
             if ( moClass != Nil ) {
-                [moClass rzv_deleteAllWhere:predicate inContext:context];
+                NSError *deleteErr = nil;
+                if ( [moClass rzv_batchDeleteAllWhere:predicate inContext:context error:&deleteErr] == nil ) {
+                    purgeErr = deleteErr;
+                    *stop = YES;
+                }
             }
             
         }];
@@ -237,7 +344,7 @@ static RZCoreDataStack *s_defaultStack = nil;
     } completion:^(NSError *err) {
         
         if (completion) {
-            completion(err);
+            completion(purgeErr ?: err);
         }
         
     }];
@@ -279,7 +386,7 @@ static RZCoreDataStack *s_defaultStack = nil;
             // Enumerate the model and discover stale predicates for each entity class
             NSMutableDictionary *classNamesToStalePredicates = [NSMutableDictionary dictionary];
             [[self.managedObjectModel entities] enumerateObjectsUsingBlock:^(NSEntityDescription *entity, NSUInteger idx, BOOL *stop) {
-                Class moClass = NSClassFromString(entity.managedObjectClassName);
+                Class moClass = [self classForEntityName:entity.name];
                 if ( moClass != Nil ) {
                     NSPredicate *predicate = [moClass rzv_stalenessPredicate];
                     if ( predicate != nil ) {
@@ -297,6 +404,42 @@ static RZCoreDataStack *s_defaultStack = nil;
 
 #pragma mark - Private
 
+- (NSManagedObjectContext *)independentBackgroundManagedObjectContext
+{
+    NSManagedObjectContext *context = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    [[context userInfo] setObject:self forKey:kRZCoreDataStackParentStackKey];
+    context.persistentStoreCoordinator = self.persistentStoreCoordinator;
+    [self configureMergePolicyForContext:context];
+    [self registerSaveNotificationsForContext:context];
+    [RZVinylContextChangeTracker trackContext:context];
+    return context;
+}
+
+- (void)configureMergePolicyForContext:(NSManagedObjectContext *)context
+{
+    if ( [self hasOptionsSet:RZCoreDataStackOptionsMergeByPropertyObjectTrump] ) {
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
+    }
+}
+
+- (void)mergeStoreChanges:(NSDictionary *)changes intoContext:(NSManagedObjectContext *)context
+{
+    // Parents must be merged before their children, so the children refresh from up-to-date parents
+    NSMutableOrderedSet *contexts = [NSMutableOrderedSet orderedSet];
+    if ( self.topLevelBackgroundContext != nil ) {
+        [contexts addObject:self.topLevelBackgroundContext];
+    }
+    [contexts addObject:self.mainManagedObjectContext];
+
+    NSMutableArray *contextChain = [NSMutableArray array];
+    for ( NSManagedObjectContext *ctx = context; ctx != nil; ctx = ctx.parentContext ) {
+        [contextChain insertObject:ctx atIndex:0];
+    }
+    [contexts addObjectsFromArray:contextChain];
+
+    [NSManagedObjectContext mergeChangesFromRemoteContextSave:changes intoContexts:[contexts array]];
+}
+
 - (BOOL)hasOptionsSet:(RZCoreDataStackOptions)options
 {
     return ( ( self.options & options ) == options );
@@ -312,6 +455,62 @@ static RZCoreDataStack *s_defaultStack = nil;
 }
 
 - (BOOL)buildStack
+{
+    if ( ![self buildCoordinator] ) {
+        return NO;
+    }
+
+    NSError *error = nil;
+    if ( ![self addPersistentStore:&error] ) {
+        @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                       reason:[NSString stringWithFormat:@"Unresolved error creating PSC for data stack: %@", error]
+                                     userInfo:nil];
+        return NO;
+    }
+
+    [self buildContexts];
+    self.ready = YES;
+    return YES;
+}
+
+- (BOOL)buildStackAsynchronouslyWithCompletion:(void (^)(NSError *))completion
+{
+    if ( ![self buildCoordinator] ) {
+        return NO;
+    }
+    [self buildContexts];
+
+    // Hold background transactions until the store is loaded
+    dispatch_suspend(self.backgroundContextQueue);
+
+    void (^loadStore)(void) = ^{
+        NSError *error = nil;
+        BOOL loaded = [self addPersistentStore:&error];
+        dispatch_resume(self.backgroundContextQueue);
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if ( loaded ) {
+                self.ready = YES;
+                [[NSNotificationCenter defaultCenter] postNotificationName:RZCoreDataStackDidBecomeReadyNotification object:self];
+            }
+            if ( completion ) {
+                completion(loaded ? nil : error);
+            }
+        });
+    };
+
+    // Loading on the top level context's queue makes the contexts above it wait for the store
+    if ( self.topLevelBackgroundContext != nil ) {
+        [self.topLevelBackgroundContext performBlock:loadStore];
+    }
+    else {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), loadStore);
+    }
+
+    return YES;
+}
+
+- (BOOL)buildCoordinator
 {
     //
     // Create model
@@ -341,17 +540,32 @@ static RZCoreDataStack *s_defaultStack = nil;
     //
     // Create PSC
     //
-    NSError *error = nil;
     if ( self.persistentStoreCoordinator == nil ) {
         self.persistentStoreCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:self.managedObjectModel];
     }
-    
-    NSMutableDictionary *options = [NSMutableDictionary dictionary];
-    
+
     if ( self.storeType == NSSQLiteStoreType ) {
         if ( !RZVAssert(self.storeURL != nil, @"Must have a store URL for SQLite stores") ) {
             return NO;
         }
+    }
+    
+    //
+    // Build entity lookup tables from the model the contexts will actually use
+    //
+    [self buildEntityTables];
+    return YES;
+}
+
+/**
+ *  Adds the store to the coordinator, which may migrate it, so the time this takes grows with the size of the database.
+ */
+- (BOOL)addPersistentStore:(NSError **)outError
+{
+    NSError *error = nil;
+    NSMutableDictionary *options = [NSMutableDictionary dictionary];
+    
+    if ( self.storeType == NSSQLiteStoreType ) {
         NSString *journalMode = [self hasOptionsSet:RZCoreDataStackOptionsDisableWriteAheadLog] ? @"DELETE" : @"WAL";
         options[NSSQLitePragmasOption] = @{@"journal_mode" : journalMode};
     }
@@ -384,16 +598,18 @@ static RZCoreDataStack *s_defaultStack = nil;
         }
         
         if ( error != nil ) {
-            @throw [NSException exceptionWithName:NSInternalInconsistencyException
-                                           reason:[NSString stringWithFormat:@"Unresolved error creating PSC for data stack: %@", error]
-                                         userInfo:nil];
+            if ( outError != NULL ) {
+                *outError = error;
+            }
             return NO;
         }
     }
-    
-    //
-    // Create Contexts
-    //
+
+    return YES;
+}
+
+- (void)buildContexts
+{
     if ( [self hasOptionsSet:RZCoreDataStackOptionsDisableTopLevelContext] ) {
         self.mainManagedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
         self.mainManagedObjectContext.persistentStoreCoordinator = self.persistentStoreCoordinator;
@@ -404,8 +620,34 @@ static RZCoreDataStack *s_defaultStack = nil;
 
         self.mainManagedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
         self.mainManagedObjectContext.parentContext = self.topLevelBackgroundContext;
+        [self configureMergePolicyForContext:self.topLevelBackgroundContext];
+        [RZVinylContextChangeTracker trackContext:self.topLevelBackgroundContext];
     }
-    return YES;
+    [self configureMergePolicyForContext:self.mainManagedObjectContext];
+    [RZVinylContextChangeTracker trackContext:self.mainManagedObjectContext];
+}
+
+- (void)buildEntityTables
+{
+    NSMutableDictionary *entitiesByClassName = [NSMutableDictionary dictionary];
+    NSMutableDictionary *classesByEntityName = [NSMutableDictionary dictionary];
+    NSString *genericClassName = NSStringFromClass([NSManagedObject class]);
+
+    for ( NSEntityDescription *entity in self.persistentStoreCoordinator.managedObjectModel.entities ) {
+        NSString *className = entity.managedObjectClassName;
+        Class moClass = NSClassFromString(className);
+        if ( moClass != Nil ) {
+            [classesByEntityName setObject:moClass forKey:entity.name];
+        }
+        // Entities without a custom class can't be looked up by class.
+        // If several entities share a class, the first one wins, as it did when lookups searched the model.
+        if ( className != nil && ![className isEqualToString:genericClassName] && [entitiesByClassName objectForKey:className] == nil ) {
+            [entitiesByClassName setObject:entity forKey:className];
+        }
+    }
+
+    self.entitiesByClassName = [NSDictionary dictionaryWithDictionary:entitiesByClassName];
+    self.classesByEntityName = [NSDictionary dictionaryWithDictionary:classesByEntityName];
 }
 
 #pragma mark - Notifications
@@ -500,6 +742,14 @@ static RZCoreDataStack *s_defaultStack = nil;
         }
     }
 
+    // Contexts that save straight to the store bypass the top level context, which must be kept
+    // up to date before the main context merges, since the main context reads through it
+    if ( self.topLevelBackgroundContext != nil && context.parentContext == nil && context != self.topLevelBackgroundContext ) {
+        [self.topLevelBackgroundContext performBlockAndWait:^{
+            [self.topLevelBackgroundContext mergeChangesFromContextDidSaveNotification:notification];
+        }];
+    }
+
     [self.mainManagedObjectContext performBlockAndWait:^{
         for ( NSManagedObject *mo in objectsToFault ) {
             NSManagedObject *mainMo = [self.mainManagedObjectContext objectWithID:[mo objectID]];
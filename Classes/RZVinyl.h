@@ -37,6 +37,7 @@
     #import "NSManagedObject+RZImport.h"
     #import "NSManagedObjectContext+RZImport.h"
     #import "NSManagedObject+RZImportableSubclass.h"
+    #import "RZVinylImportMetrics.h"
 #endif
 
 
@@ -16,4 +16,16 @@
     return [NSPredicate predicateWithFormat:@"songs.@count == 0"];
 }
 
++ (NSArray *)rzv_relationshipKeyPathsForPrefetching
+{
+    // artist lists show song counts
+    return @[@"songs"];
+}
+
++ (NSArray *)rzi_ignoredKeys
+{
+    // legacy payloads still send a genre that is no longer trusted
+    return @[@"legacyGenre"];
+}
+
 @end
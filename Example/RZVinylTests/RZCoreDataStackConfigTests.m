@@ -194,4 +194,58 @@ static NSString* const kRZCoreDataStackCustomFilePath = @"test_tmp/RZCoreDataSta
     XCTAssertNotNil(stack2.persistentStoreCoordinator, @"PSC should not be nil");
 }
 
+
+- (void)test_AsynchronousInit
+{
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.customFileURL path]], @"sqlite file should not exist yet");
+
+    [self expectationForNotification:RZCoreDataStackDidBecomeReadyNotification object:nil handler:nil];
+    XCTestExpectation *loaded = [self expectationWithDescription:@"Store loaded"];
+
+    RZCoreDataStack *stack = nil;
+    XCTAssertNoThrow(stack = [[RZCoreDataStack alloc] initWithModelName:@"RZVinylDemo"
+                                                          configuration:nil
+                                                              storeType:NSSQLiteStoreType
+                                                               storeURL:self.customFileURL
+                                             persistentStoreCoordinator:nil
+                                                                options:kNilOptions
+                                                             completion:^(NSError *err) {
+                                                                 XCTAssertNil(err, @"Store failed to load: %@", err);
+                                                                 [loaded fulfill];
+                                                             }], @"Init threw an exception");
+
+    XCTAssertNotNil(stack, @"Stack should not be nil");
+    XCTAssertNotNil(stack.mainManagedObjectContext, @"MOC should be available before the store is loaded");
+    XCTAssertFalse(stack.isReady, @"Stack should not be ready until the store is loaded");
+
+    // Work on the main context waits for the store
+    NSEntityDescription *entity = [stack.managedObjectModel.entities firstObject];
+    NSError *fetchErr = nil;
+    NSUInteger count = [stack.mainManagedObjectContext countForFetchRequest:[NSFetchRequest fetchRequestWithEntityName:entity.name] error:&fetchErr];
+    XCTAssertNil(fetchErr, @"Fetch before the store was ready failed: %@", fetchErr);
+    XCTAssertEqual(count, 0, @"New store should be empty");
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertTrue(stack.isReady, @"Stack should be ready");
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:[self.customFileURL path]], @"sqlite file not created");
+
+    // Load errors are reported rather than thrown
+    NSURL *testModelURL = [[NSBundle bundleForClass:[self class]] URLForResource:@"TestModel" withExtension:@"momd"];
+    NSManagedObjectModel *testModel = [[NSManagedObjectModel alloc] initWithContentsOfURL:testModelURL];
+    XCTestExpectation *failed = [self expectationWithDescription:@"Store failed to load"];
+    RZCoreDataStack *stack2 = nil;
+    XCTAssertNoThrow(stack2 = [[RZCoreDataStack alloc] initWithModel:testModel
+                                                           storeType:NSSQLiteStoreType
+                                                            storeURL:self.customFileURL
+                                          persistentStoreCoordinator:nil
+                                                             options:RZCoreDataStackOptionsDisableAutoLightweightMigration
+                                                          completion:^(NSError *err) {
+                                                              XCTAssertNotNil(err, @"Unreadable store should fail to load");
+                                                              [failed fulfill];
+                                                          }], @"Init threw an exception");
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertFalse(stack2.isReady, @"Stack should not be ready if the store failed to load");
+}
+
 @end
@@ -8,6 +8,27 @@
 
 #import "RZVinylBaseTestCase.h"
 
+// The private primary key lookup's test initializer, which overrides its tunables
+@interface NSObject (RZVinylPrimaryKeyLookupTesting)
+
+- (instancetype)initWithEntity:(NSEntityDescription *)entity
+                    primaryKey:(NSString *)primaryKey
+                       context:(NSManagedObjectContext *)context
+                      keysOnly:(BOOL)keysOnly
+                     chunkSize:(NSUInteger)chunkSize
+            rangeScanThreshold:(NSUInteger)rangeScanThreshold;
+
+- (NSDictionary *)objectsByPrimaryKeyValue:(NSSet *)primaryValues fetchCount:(NSUInteger *)fetchCount;
+
+@end
+
+// The private import plan cache
+@interface NSObject (RZVinylImportPlanTesting)
+
++ (void)removeCachedPlansForCurrentThread;
+
+@end
+
 @interface RZVinylImportTests : RZVinylBaseTestCase
 
 @property (nonatomic, strong) NSArray *rawArtists;
@@ -277,5 +298,794 @@
     XCTAssertEqual([[Artist rzv_all] count], count, @"Failed to import artists");
 }
 
+- (void)test_PrefetchedGraphImport
+{
+    // Small enough that each entity's keys fit in a single IN predicate
+    const NSUInteger count = 400;
+
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        [artistArray addObject:@{
+            @"id" : @(i+1),
+            @"name" : @"Rick Astley",
+            @"songs" : @[
+                @{ @"id" : @(1000+i), @"title" : @"Never Gonna Give You Up" },
+                // Shared by every artist, must only be created once
+                @{ @"id" : @1337, @"title" : @"Together Forever" }
+            ]
+        }];
+    }
+
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+    RZVinylImportMetrics *metrics = [[RZVinylImportMetrics alloc] init];
+    [context rzi_setImportMetrics:metrics];
+
+    __block NSArray *artists = nil;
+    uint64_t time = dispatch_benchmark(1, ^{
+        artists = [Artist rzi_objectsFromArray:artistArray inContext:context withMappings:nil options:RZVinylImportOptionsPrefetchRelationships];
+    });
+
+    NSLog(@"Prefetched import of %lu artists took %f s", (unsigned long)count, (double)time/NSEC_PER_SEC);
+
+    // One fetch per entity, rather than one per artist for its songs
+    XCTAssertEqual(metrics.lastReport.entityMetrics[@"Artist"].prefetchQueryCount, 1, @"Artists should be resolved with one fetch");
+    XCTAssertEqual(metrics.lastReport.entityMetrics[@"Song"].prefetchQueryCount, 1, @"Songs should be resolved with one fetch");
+
+    XCTAssertEqual(artists.count, count, @"Incorrect number of artists imported");
+    XCTAssertEqual([Artist rzv_countInContext:context], count, @"Duplicate artists were created");
+    XCTAssertEqual([Song rzv_countInContext:context], count + 1, @"Duplicate songs were created");
+    XCTAssertEqual([[artists lastObject] songs].count, 2, @"Failed to import songs");
+
+    // Importing again should only update the existing objects
+    NSMutableArray *updatedArray = [NSMutableArray array];
+    [artistArray enumerateObjectsUsingBlock:^(NSDictionary *artistDict, NSUInteger idx, BOOL *stop) {
+        NSMutableDictionary *updatedDict = [artistDict mutableCopy];
+        updatedDict[@"name"] = @"Richard Astley";
+        [updatedArray addObject:updatedDict];
+    }];
+
+    artists = [Artist rzi_objectsFromArray:updatedArray inContext:context withMappings:nil options:RZVinylImportOptionsPrefetchRelationships];
+
+    // Everything imported above is still registered in the context
+    XCTAssertEqual(metrics.lastReport.entityMetrics[@"Artist"].prefetchQueryCount, 0, @"No artist fetches should be needed on update");
+    XCTAssertEqual(metrics.lastReport.entityMetrics[@"Song"].prefetchQueryCount, 0, @"No song fetches should be needed on update");
+    [context rzi_setImportMetrics:nil];
+
+    XCTAssertEqual([Artist rzv_countInContext:context], count, @"Duplicate artists were created on update");
+    XCTAssertEqual([Song rzv_countInContext:context], count + 1, @"Duplicate songs were created on update");
+    NSSet *artistNames = [NSSet setWithArray:[artists valueForKey:@"name"]];
+    XCTAssertEqualObjects(artistNames, [NSSet setWithObject:@"Richard Astley"], @"Failed to update artists");
+}
+
+- (void)test_ParallelImportScaling
+{
+    const NSUInteger count = 2000;
+
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        [artistArray addObject:@{
+            @"id" : @(i+1),
+            @"name" : @"Rick Astley",
+            @"genre" : @"Pop",
+            @"songs" : @[ @{ @"id" : @(100000+i), @"title" : @"Never Gonna Give You Up" } ]
+        }];
+    }
+
+    // Warm up the metadata caches so only the steady state is measured
+    [Artist rzi_objectsFromArray:[artistArray subarrayWithRange:NSMakeRange(0, 1)] inContext:[self.stack backgroundManagedObjectContext]];
+
+    for ( NSNumber *threadCount in @[@1, @2, @4, @8] ) {
+        const size_t threads = [threadCount unsignedIntegerValue];
+        const NSUInteger sliceLength = count / threads;
+        NSMutableArray *importedIDs = [NSMutableArray array];
+
+        uint64_t time = dispatch_benchmark(1, ^{
+            dispatch_apply(threads, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t idx) {
+                NSArray *slice = [artistArray subarrayWithRange:NSMakeRange(idx * sliceLength, sliceLength)];
+                NSManagedObjectContext *context = [self.stack backgroundManagedObjectContext];
+                NSArray *artists = [Artist rzi_objectsFromArray:slice inContext:context];
+                __block NSArray *sliceIDs = nil;
+                [context performBlockAndWait:^{
+                    sliceIDs = [artists valueForKey:@"remoteID"];
+                }];
+                @synchronized ( importedIDs ) {
+                    [importedIDs addObjectsFromArray:sliceIDs];
+                }
+            });
+        });
+
+        // Timing depends on the cores available, so it is only logged
+        NSLog(@"Parallel import of %lu artists on %lu threads took %f s", (unsigned long)count, (unsigned long)threads, (double)time/NSEC_PER_SEC);
+
+        XCTAssertEqual(importedIDs.count, count, @"Incorrect number of artists imported on %lu threads", (unsigned long)threads);
+        XCTAssertEqual([NSSet setWithArray:importedIDs].count, count, @"Duplicate artists imported on %lu threads", (unsigned long)threads);
+    }
+}
+
+- (void)test_ChunkedImport
+{
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < 1000; i++ ) {
+        [artistArray addObject:@{
+            @"id" : @(i+1),
+            @"name" : @"Rick Astley",
+            @"genre" : @"Pop",
+            @"songs" : @[ @{ @"id" : @(100000+i), @"title" : @"Never Gonna Give You Up" } ]
+        }];
+    }
+
+    NSManagedObjectContext *context = [self.stack backgroundManagedObjectContext];
+
+    __block NSUInteger progressCalls = 0;
+    NSArray *objectIDs = nil;
+    NSError *err = nil;
+    BOOL success = [Artist rzi_importObjectsFromArray:artistArray
+                                            inContext:context
+                                         withMappings:nil
+                                              options:kNilOptions
+                                            chunkSize:100
+                                            objectIDs:&objectIDs
+                                             progress:^(NSUInteger importedCount, NSUInteger totalCount, BOOL *stop) {
+                                                 progressCalls++;
+                                                 XCTAssertEqual(importedCount, progressCalls * 100, @"Wrong imported count");
+                                                 XCTAssertEqual(totalCount, 1000, @"Wrong total count");
+                                             }
+                                                error:&err];
+
+    XCTAssertTrue(success, @"Chunked import failed");
+    XCTAssertNil(err, @"Chunked import failed: %@", err);
+    XCTAssertEqual(progressCalls, 10, @"Progress should be reported once per chunk");
+    XCTAssertEqual(objectIDs.count, 1000, @"Wrong number of object IDs");
+    XCTAssertEqual([[objectIDs filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"temporaryID == NO"]] count], 1000, @"All object IDs should be permanent");
+
+    // Everything should have been saved to the store
+    XCTAssertEqual([Artist rzv_countWhere:[NSPredicate predicateWithFormat:@"name == %@", @"Rick Astley"]], 1000, @"Artists were not saved");
+    XCTAssertEqual([Song rzv_countWhere:[NSPredicate predicateWithFormat:@"title == %@", @"Never Gonna Give You Up"]], 1000, @"Songs were not saved");
+
+    // Stopping early saves only the completed chunks
+    NSMutableArray *moreArtists = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < 100; i++ ) {
+        [moreArtists addObject:@{ @"id" : @(5000+i), @"name" : @"Stopped Early" }];
+    }
+
+    success = [Artist rzi_importObjectsFromArray:moreArtists
+                                       inContext:context
+                                    withMappings:nil
+                                         options:kNilOptions
+                                       chunkSize:30
+                                       objectIDs:NULL
+                                        progress:^(NSUInteger importedCount, NSUInteger totalCount, BOOL *stop) {
+                                            *stop = YES;
+                                        }
+                                           error:&err];
+
+    XCTAssertTrue(success, @"Stopped import should still succeed");
+    XCTAssertEqual([Artist rzv_countWhere:[NSPredicate predicateWithFormat:@"name == %@", @"Stopped Early"]], 30, @"Only the first chunk should have been saved");
+}
+
+- (void)test_StreamingJSONImport
+{
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < 1000; i++ ) {
+        [artistArray addObject:@{
+            @"id" : @(i+1),
+            @"name" : @"Rick \"Never [Gonna]\" {Astley}",
+            @"genre" : @"Pop\\",
+            @"songs" : @[ @{ @"id" : @(100000+i), @"title" : @"Never Gonna Give You Up" } ]
+        }];
+    }
+
+    NSURL *fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"rzv_stream_test.json"]];
+    NSData *jsonData = [NSJSONSerialization dataWithJSONObject:artistArray options:NSJSONWritingPrettyPrinted error:NULL];
+    XCTAssertTrue([jsonData writeToURL:fileURL atomically:YES], @"Failed to write test JSON");
+
+    XCTestExpectation *importExpectation = [self expectationWithDescription:@"Streaming import complete"];
+    __block NSUInteger progressCalls = 0;
+
+    [Artist rzi_importObjectsFromJSONFileURL:fileURL
+                                   inContext:[self.stack backgroundManagedObjectContext]
+                                withMappings:nil
+                                     options:kNilOptions
+                                   batchSize:64
+                                    progress:^(NSUInteger importedCount, NSUInteger totalCount, BOOL *stop) {
+                                        progressCalls++;
+                                        XCTAssertEqual(totalCount, NSNotFound, @"Total count should not be known");
+                                    }
+                                  completion:^(NSUInteger importedCount, NSError *error) {
+                                      XCTAssertTrue([NSThread isMainThread], @"Completion should be called on the main thread");
+                                      XCTAssertNil(error, @"Streaming import failed: %@", error);
+                                      XCTAssertEqual(importedCount, 1000, @"Wrong number of objects imported");
+                                      [importExpectation fulfill];
+                                  }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    XCTAssertEqual(progressCalls, 16, @"Progress should be reported once per batch");
+    XCTAssertEqual([Artist rzv_countWhere:[NSPredicate predicateWithFormat:@"name == %@", @"Rick \"Never [Gonna]\" {Astley}"]], 1000, @"Artists were not saved");
+    XCTAssertEqual([Song rzv_countWhere:[NSPredicate predicateWithFormat:@"title == %@", @"Never Gonna Give You Up"]], 1000, @"Songs were not saved");
+
+    // Malformed JSON imports everything before the error and reports it
+    NSData *badData = [@"[ { \"id\" : 5001, \"name\" : \"Good\" }, { \"id\" : 5002, \"name\" : " dataUsingEncoding:NSUTF8StringEncoding];
+    XCTestExpectation *badExpectation = [self expectationWithDescription:@"Malformed import complete"];
+
+    [Artist rzi_importObjectsFromJSONStream:[NSInputStream inputStreamWithData:badData]
+                                  inContext:[self.stack backgroundManagedObjectContext]
+                               withMappings:nil
+                                    options:kNilOptions
+                                  batchSize:1
+                                   progress:nil
+                                 completion:^(NSUInteger importedCount, NSError *error) {
+                                     XCTAssertNotNil(error, @"Malformed JSON should produce an error");
+                                     XCTAssertEqualObjects(error.domain, RZVinylImportErrorDomain, @"Wrong error domain");
+                                     XCTAssertEqual(importedCount, 1, @"Elements before the error should be imported");
+                                     [badExpectation fulfill];
+                                 }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    // A trailing comma is not valid JSON either
+    NSData *trailingCommaData = [@"[ { \"id\" : 5003, \"name\" : \"Good\" }, ]" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTestExpectation *trailingCommaExpectation = [self expectationWithDescription:@"Trailing comma import complete"];
+
+    [Artist rzi_importObjectsFromJSONStream:[NSInputStream inputStreamWithData:trailingCommaData]
+                                  inContext:[self.stack backgroundManagedObjectContext]
+                               withMappings:nil
+                                    options:kNilOptions
+                                  batchSize:1
+                                   progress:nil
+                                 completion:^(NSUInteger importedCount, NSError *error) {
+                                     XCTAssertNotNil(error, @"A trailing comma should produce an error");
+                                     XCTAssertEqual(error.code, RZVinylImportErrorInvalidJSON, @"Wrong error code");
+                                     XCTAssertEqual(importedCount, 1, @"Elements before the error should be imported");
+                                     [trailingCommaExpectation fulfill];
+                                 }];
+
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:NULL];
+}
+
+- (void)test_ShardedParallelImport
+{
+    const NSUInteger count = 4000;
+
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        // Mix string and number keys, which must still land in the same shard as each other
+        id remoteID = ( i % 2 == 0 ) ? @(i+1) : [NSString stringWithFormat:@"%lu", (unsigned long)(i+1)];
+        [artistArray addObject:@{ @"id" : remoteID, @"name" : @"Rick Astley", @"genre" : @"Pop" }];
+    }
+
+    // Every key again, in the other representation, should update rather than duplicate
+    NSMutableArray *updateArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        id remoteID = ( i % 2 == 0 ) ? [NSString stringWithFormat:@"%lu", (unsigned long)(i+1)] : @(i+1);
+        [updateArray addObject:@{ @"id" : remoteID, @"name" : @"Richard Astley" }];
+    }
+
+    for ( NSNumber *shardCount in @[@1, @4] ) {
+        XCTestExpectation *importExpectation = [self expectationWithDescription:@"Parallel import complete"];
+        NSDate *start = [NSDate date];
+
+        [Artist rzi_importObjectsFromArray:artistArray withMappings:nil options:kNilOptions shardCount:[shardCount unsignedIntegerValue] completion:^(NSError *error) {
+            XCTAssertNil(error, @"Parallel import failed: %@", error);
+            [importExpectation fulfill];
+        }];
+
+        [self waitForExpectationsWithTimeout:30 handler:nil];
+        NSLog(@"Sharded import of %lu artists on %@ contexts took %f s", (unsigned long)count, shardCount, -[start timeIntervalSinceNow]);
+    }
+
+    XCTestExpectation *updateExpectation = [self expectationWithDescription:@"Parallel update complete"];
+    [Artist rzi_importObjectsFromArray:updateArray withMappings:nil options:kNilOptions shardCount:0 completion:^(NSError *error) {
+        XCTAssertNil(error, @"Parallel update failed: %@", error);
+        [updateExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+
+    NSPredicate *importedArtists = [NSPredicate predicateWithFormat:@"remoteID > 0 AND remoteID <= %@", @(count)];
+    XCTAssertEqual([Artist rzv_countWhere:importedArtists], count, @"Parallel import created duplicate artists");
+    XCTAssertEqual([Artist rzv_countWhere:nil], count, @"Parallel import created unexpected artists");
+    XCTAssertEqual([Artist rzv_countWhere:[NSPredicate predicateWithFormat:@"name == %@", @"Richard Astley"]], count, @"Updates were not merged into the main context");
+}
+
+- (void)test_ShardedParallelImportWithSharedNestedObjects
+{
+    const NSUInteger count = 400;
+
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        [artistArray addObject:@{
+            @"id" : @(i+1),
+            @"name" : @"Rick Astley",
+            @"songs" : @[
+                @{ @"id" : @(1000+i), @"title" : @"Never Gonna Give You Up" },
+                // Shared by every artist, so it is referenced from every shard
+                @{ @"id" : @1337, @"title" : @"Together Forever" }
+            ]
+        }];
+    }
+
+    XCTestExpectation *importExpectation = [self expectationWithDescription:@"Parallel import complete"];
+    [Artist rzi_importObjectsFromArray:artistArray withMappings:nil options:kNilOptions shardCount:4 completion:^(NSError *error) {
+        XCTAssertNil(error, @"Parallel import failed: %@", error);
+        [importExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+
+    XCTAssertEqual([Artist rzv_countWhere:nil], count, @"Parallel import created duplicate artists");
+    XCTAssertEqual([Song rzv_countWhere:nil], count + 1, @"Parallel import created duplicate songs");
+    XCTAssertEqual([Song rzv_countWhere:[NSPredicate predicateWithFormat:@"remoteID == %@", @1337]], 1, @"The shared song should only be created once");
+    XCTAssertNotNil([[Song rzv_objectWithPrimaryKeyValue:@1337 createNew:NO] artist], @"The shared song should be related to an artist");
+}
+
+- (void)test_FullSyncImport
+{
+    [self seedDatabase];
+    XCTAssertEqual([Artist rzv_countWhere:nil], 3, @"Database was not seeded");
+
+    // Scoped sync only removes missing artists inside the scope
+    NSError *err = nil;
+    NSArray *artists = [Artist rzi_syncObjectsFromArray:@[ @{ @"id" : @1000, @"name" : @"Dusky" } ]
+                                              inContext:self.stack.mainManagedObjectContext
+                                           withMappings:nil
+                                                options:kNilOptions
+                                                  scope:[NSPredicate predicateWithFormat:@"genre == %@", @"Drum & Bass"]
+                                                  error:&err];
+
+    XCTAssertNil(err, @"Sync failed: %@", err);
+    XCTAssertEqual(artists.count, 1, @"Wrong number of artists imported");
+    XCTAssertEqual([Artist rzv_countWhere:nil], 2, @"Only the out-of-scope artist should remain besides the synced one");
+    XCTAssertNil([Artist rzv_objectWithPrimaryKeyValue:@1049 createNew:NO], @"Missing artist in scope should be deleted");
+    XCTAssertNotNil([Artist rzv_objectWithPrimaryKeyValue:@2399 createNew:NO], @"Missing artist out of scope should be kept");
+
+    // Unscoped sync leaves exactly the payload, including new objects
+    artists = [Artist rzi_syncObjectsFromArray:@[ @{ @"id" : @"1000", @"name" : @"Dusky" }, @{ @"id" : @5, @"name" : @"Rick Astley" } ]
+                                     inContext:self.stack.mainManagedObjectContext
+                                  withMappings:nil
+                                       options:kNilOptions
+                                         scope:nil
+                                         error:&err];
+
+    XCTAssertNil(err, @"Sync failed: %@", err);
+    XCTAssertEqual(artists.count, 2, @"Wrong number of artists imported");
+    XCTAssertEqual([Artist rzv_countWhere:nil], 2, @"Artists missing from the payload should be deleted");
+    XCTAssertNil([Artist rzv_objectWithPrimaryKeyValue:@2399 createNew:NO], @"Missing artist should be deleted");
+    XCTAssertEqual([Song rzv_countWhere:[NSPredicate predicateWithFormat:@"title == %@", @"Lateralus"]], 0, @"Delete rules should still be applied");
+
+    XCTAssertTrue([self.stack.mainManagedObjectContext rzv_saveToStoreAndWait:&err], @"Save failed: %@", err);
+    XCTAssertEqual([Artist rzv_countWhere:nil], 2, @"Sync was not saved");
+}
+
+- (void)test_SkipUnchangedValues
+{
+    [self seedDatabase];
+
+    // Same values that were seeded, without the keys the seed skips
+    NSMutableArray *payload = [NSMutableArray array];
+    for ( NSDictionary *rawArtist in self.rawArtists ) {
+        NSMutableDictionary *artist = [[rawArtist dictionaryWithValuesForKeys:@[@"id", @"name", @"genre"]] mutableCopy];
+        NSMutableArray *songs = [NSMutableArray array];
+        for ( NSDictionary *rawSong in rawArtist[@"songs"] ) {
+            NSMutableDictionary *song = [NSMutableDictionary dictionaryWithDictionary:@{ @"id" : rawSong[@"id"], @"title" : rawSong[@"title"] }];
+            if ( rawSong[@"length"] != nil ) {
+                song[@"length"] = rawSong[@"length"];
+            }
+            [songs addObject:song];
+        }
+        artist[@"songs"] = songs;
+        [payload addObject:artist];
+    }
+
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+
+    NSUInteger changedCount = [context rzi_performImport:^{
+        [Artist rzi_objectsFromArray:payload];
+    } options:RZVinylImportOptionsSkipUnchangedValues];
+
+    XCTAssertEqual(changedCount, 0, @"No objects should have changed");
+    XCTAssertFalse(context.hasChanges, @"Unchanged values should not dirty the context");
+
+    // Only the artist that actually changed is updated
+    NSMutableDictionary *tool = [payload.lastObject mutableCopy];
+    tool[@"name"] = @"Tool (Live)";
+    [payload replaceObjectAtIndex:payload.count - 1 withObject:tool];
+
+    changedCount = [context rzi_performImport:^{
+        [Artist rzi_objectsFromArray:payload];
+    } options:RZVinylImportOptionsSkipUnchangedValues];
+
+    XCTAssertEqual(changedCount, 1, @"Only one object should have changed");
+    XCTAssertEqual(context.updatedObjects.count, 1, @"Only the changed artist should be updated");
+    XCTAssertEqualObjects([[context.updatedObjects anyObject] valueForKey:@"name"], @"Tool (Live)", @"Wrong artist updated");
+
+    // Without the option every imported object is written
+    [context rollback];
+    changedCount = [context rzi_performImport:^{
+        [Artist rzi_objectsFromArray:payload];
+    } options:kNilOptions];
+
+    XCTAssertGreaterThan(changedCount, 1, @"Every imported object should be counted without the option");
+}
+
+- (void)test_CachedImportPlans
+{
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < 1000; i++ ) {
+        [artistArray addObject:@{
+            @"id" : @(i+1),
+            @"name" : @"Rick Astley",
+            @"genre" : @"Pop",
+            @"popularity" : @(i),
+            @"songs" : @[
+                @{ @"id" : @(100000+i*3),   @"title" : @"Never Gonna Give You Up", @"length" : @213 },
+                @{ @"id" : @(100000+i*3+1), @"title" : @"Together Forever", @"length" : @205 },
+                @{ @"id" : @(100000+i*3+2), @"title" : @"Whenever You Need Somebody", @"length" : @238 }
+            ]
+        }];
+    }
+
+    NSManagedObjectContext *context = [self.stack backgroundManagedObjectContext];
+    [Artist rzi_objectsFromArray:artistArray inContext:context];
+
+    // The same update payload, with the plans compiled by the first import and with plans compiled every time.
+    // Plans are cached per thread, so the cache is cleared on the context's queue.
+    Class planClass = NSClassFromString(@"RZVinylImportPlan");
+    XCTAssertNotNil(planClass, @"Import plans are missing");
+
+    __block NSArray *artists = nil;
+    uint64_t warmTime = dispatch_benchmark(5, ^{
+        artists = [Artist rzi_objectsFromArray:artistArray inContext:context];
+    });
+
+    uint64_t coldTime = dispatch_benchmark(5, ^{
+        [context performBlockAndWait:^{
+            [planClass removeCachedPlansForCurrentThread];
+            artists = [Artist rzi_objectsFromArray:artistArray inContext:context];
+        }];
+    });
+
+    NSLog(@"Update of %lu artists took %f s with cached plans, %f s compiling plans", (unsigned long)artistArray.count, (double)warmTime/NSEC_PER_SEC, (double)coldTime/NSEC_PER_SEC);
+
+    XCTAssertEqual(artists.count, artistArray.count, @"Wrong number of artists imported");
+    [context performBlockAndWait:^{
+        Artist *artist = [Artist rzv_objectWithPrimaryKeyValue:@500 createNew:NO inContext:context];
+        XCTAssertEqualObjects(artist.name, @"Rick Astley", @"Wrong name imported");
+        XCTAssertEqualObjects(artist.popularity, @499, @"Wrong popularity imported");
+        XCTAssertEqual(artist.songs.count, 3, @"Wrong number of songs imported");
+        XCTAssertEqual([Song rzv_countWhere:nil inContext:context], 3000, @"Songs should not be duplicated");
+    }];
+}
+
+- (void)test_ImportPlanSkipsIgnoredKeys
+{
+    // Artist ignores legacyGenre, even when it is mapped to a modeled attribute
+    NSDictionary *mappings = @{ @"legacyGenre" : @"genre" };
+    NSArray *payload = @[ @{ @"id" : @1, @"name" : @"Rick Astley", @"legacyGenre" : @"Polka" } ];
+
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+    Artist *artist = [[Artist rzi_objectsFromArray:payload inContext:context withMappings:mappings] firstObject];
+    XCTAssertNotNil(artist, @"Artist was not imported");
+    XCTAssertEqualObjects(artist.name, @"Rick Astley", @"Name was not imported");
+    XCTAssertNil(artist.genre, @"Ignored key should not be imported");
+
+    // Again with the plan already compiled, now as an update
+    artist.genre = @"Pop";
+    [Artist rzi_objectsFromArray:payload inContext:context withMappings:mappings];
+    XCTAssertEqualObjects(artist.genre, @"Pop", @"Ignored key should not be imported into an existing object");
+}
+
+- (void)test_ImportMetrics
+{
+    NSArray *payload = @[
+        @{ @"id" : @1, @"name" : @"Rick Astley", @"songs" : @[ @{ @"id" : @10, @"title" : @"Never Gonna Give You Up" }, @{ @"id" : @11, @"title" : @"Together Forever" } ] },
+        @{ @"id" : @2, @"name" : @"Bananarama", @"songs" : @[ @{ @"id" : @20, @"title" : @"Venus" }, @{ @"id" : @21, @"title" : @"Cruel Summer" } ] }
+    ];
+
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+    RZVinylImportMetrics *metrics = [[RZVinylImportMetrics alloc] init];
+    [context rzi_setImportMetrics:metrics];
+
+    [Artist rzi_objectsFromArray:payload inContext:context];
+
+    RZVinylImportReport *report = metrics.lastReport;
+    XCTAssertNotNil(report, @"A report should be produced at the end of the import");
+    NSLog(@"%@", report);
+
+    RZVinylImportEntityMetrics *artistMetrics = report.entityMetrics[@"Artist"];
+    RZVinylImportEntityMetrics *songMetrics = report.entityMetrics[@"Song"];
+    XCTAssertEqual(artistMetrics.insertCount, 2, @"Wrong number of artist inserts");
+    XCTAssertEqual(artistMetrics.prefetchQueryCount, 1, @"Artists should be resolved with one fetch");
+    XCTAssertEqual(artistMetrics.relationshipImportCount, 2, @"Wrong number of relationship imports");
+    XCTAssertEqual(songMetrics.insertCount, 4, @"Wrong number of song inserts");
+    XCTAssertEqual(songMetrics.prefetchQueryCount, 2, @"Songs should be resolved with one fetch per artist");
+    XCTAssertGreaterThanOrEqual(report.duration, artistMetrics.duration + songMetrics.duration, @"Entity durations should not overlap");
+
+    XCTAssertTrue([context rzv_saveToStoreAndWait:NULL], @"Save failed");
+
+    // Re-importing the same payload resolves everything from the identity map and changes nothing
+    [Artist rzi_objectsFromArray:payload inContext:context withMappings:nil options:RZVinylImportOptionsSkipUnchangedValues];
+
+    report = metrics.lastReport;
+    artistMetrics = report.entityMetrics[@"Artist"];
+    songMetrics = report.entityMetrics[@"Song"];
+    XCTAssertEqual(artistMetrics.prefetchQueryCount, 0, @"No artist fetches should be needed");
+    XCTAssertEqual(artistMetrics.identityMapHitCount, 2, @"Artists should be found in the identity map");
+    XCTAssertEqual(artistMetrics.unchangedCount, 2, @"Artists should be unchanged");
+    XCTAssertEqual(songMetrics.prefetchQueryCount, 0, @"No song fetches should be needed");
+    XCTAssertEqual(songMetrics.identityMapHitCount, 4, @"Songs should be found in the identity map");
+    XCTAssertEqual(songMetrics.unchangedCount, 4, @"Songs should be unchanged");
+
+    [context rzi_setImportMetrics:nil];
+}
+
+- (void)test_ImportIntoFaultedObjects
+{
+    NSArray *payload = @[
+        @{ @"id" : @1, @"name" : @"Rick Astley" },
+        @{ @"id" : @2, @"name" : @"Bananarama" }
+    ];
+
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+    NSArray *artists = [Artist rzi_objectsFromArray:payload inContext:context];
+    XCTAssertTrue([context rzv_saveToStoreAndWait:NULL], @"Save failed");
+
+    // Turning the objects back into faults must not cost a fetch on the next lookup
+    for ( Artist *artist in artists ) {
+        [context refreshObject:artist mergeChanges:NO];
+        XCTAssertTrue(artist.isFault, @"Object should be a fault");
+    }
+
+    RZVinylImportMetrics *metrics = [[RZVinylImportMetrics alloc] init];
+    [context rzi_setImportMetrics:metrics];
+
+    NSArray *reimportedArtists = [Artist rzi_objectsFromArray:payload inContext:context];
+
+    RZVinylImportEntityMetrics *artistMetrics = metrics.lastReport.entityMetrics[@"Artist"];
+    XCTAssertEqual(artistMetrics.prefetchQueryCount, 0, @"Faulted artists should not be fetched");
+    XCTAssertEqual(artistMetrics.identityMapHitCount, 2, @"Faulted artists should be found in the identity map");
+    XCTAssertEqualObjects([NSSet setWithArray:reimportedArtists], [NSSet setWithArray:artists], @"Should import into the same instances");
+    XCTAssertEqual([Artist rzv_countInContext:context], 2, @"Duplicate artists were created");
+
+    [context rzi_setImportMetrics:nil];
+}
+
+- (void)test_ImportIntoFaultsDeletedElsewhere
+{
+    // Without a top-level context, a context outside the stack can delete rows without the deletion being merged
+    RZCoreDataStack *stack = [[RZCoreDataStack alloc] initWithModel:self.stack.managedObjectModel
+                                                          storeType:NSInMemoryStoreType
+                                                           storeURL:nil
+                                         persistentStoreCoordinator:nil
+                                                            options:RZCoreDataStackOptionsDisableTopLevelContext];
+    [RZCoreDataStack setDefaultStack:stack];
+
+    NSArray *payload = @[
+        @{ @"id" : @1, @"name" : @"Rick Astley" },
+        @{ @"id" : @2, @"name" : @"Bananarama" }
+    ];
+
+    NSManagedObjectContext *context = stack.mainManagedObjectContext;
+    NSArray *artists = [Artist rzi_objectsFromArray:payload inContext:context];
+    XCTAssertTrue([context rzv_saveToStoreAndWait:NULL], @"Save failed");
+
+    NSManagedObjectContext *otherContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    otherContext.persistentStoreCoordinator = stack.persistentStoreCoordinator;
+    NSManagedObjectID *deletedID = [[artists firstObject] objectID];
+    [otherContext performBlockAndWait:^{
+        [otherContext deleteObject:[otherContext objectWithID:deletedID]];
+        NSError *err = nil;
+        XCTAssertTrue([otherContext save:&err], @"Save failed: %@", err);
+    }];
+
+    for ( Artist *artist in artists ) {
+        [context refreshObject:artist mergeChanges:NO];
+    }
+
+    // The dead fault must be dropped from the identity map, not assigned to
+    NSArray *reimportedArtists = nil;
+    XCTAssertNoThrow(reimportedArtists = [Artist rzi_objectsFromArray:payload inContext:context], @"Import fired a dead fault");
+    XCTAssertEqual(reimportedArtists.count, 2, @"Both artists should be imported");
+    XCTAssertFalse([reimportedArtists containsObject:[artists firstObject]], @"The deleted artist should have been recreated");
+    XCTAssertTrue([reimportedArtists containsObject:[artists lastObject]], @"The live artist should be reused");
+    XCTAssertEqualObjects([[reimportedArtists firstObject] name], @"Rick Astley", @"Recreated artist was not imported");
+}
+
+- (void)test_FetchKeysOnlyImport
+{
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < 1000; i++ ) {
+        [artistArray addObject:@{ @"id" : @(i+1), @"name" : @"Rick Astley", @"genre" : @"Pop" }];
+    }
+
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+    [Artist rzi_objectsFromArray:artistArray inContext:context];
+
+    NSError *err = nil;
+    XCTAssertTrue([context rzv_saveToStoreAndWait:&err], @"Save failed: %@", err);
+    [context reset];
+
+    // An unsaved object is not in the store, but must still be found
+    Artist *pending = [Artist rzv_newObjectInContext:context];
+    pending.remoteID = @2000;
+    pending.name = @"Bananarama";
+
+    NSMutableArray *payload = [NSMutableArray array];
+    for ( NSDictionary *artist in artistArray ) {
+        NSMutableDictionary *updated = [artist mutableCopy];
+        updated[@"name"] = @"Rick Astley (Remastered)";
+        [payload addObject:updated];
+    }
+    [payload addObject:@{ @"id" : @2000, @"name" : @"Bananarama", @"genre" : @"Pop" }];
+
+    NSArray *artists = [Artist rzi_objectsFromArray:payload inContext:context withMappings:nil options:RZVinylImportOptionsFetchKeysOnly];
+
+    XCTAssertEqual(artists.count, payload.count, @"Wrong number of artists imported");
+    XCTAssertEqual([Artist rzv_countWhere:nil inContext:context], payload.count, @"Existing artists should not be duplicated");
+    XCTAssertEqual(context.insertedObjects.count, 1, @"Only the pending artist should be inserted");
+    XCTAssertTrue([artists containsObject:pending], @"The pending artist should be updated in place");
+
+    Artist *artist = [Artist rzv_objectWithPrimaryKeyValue:@500 createNew:NO inContext:context];
+    XCTAssertEqualObjects(artist.name, @"Rick Astley (Remastered)", @"Wrong name imported");
+    XCTAssertEqualObjects(artist.genre, @"Pop", @"Values not in the payload should be kept");
+}
+
+- (void)test_PrimaryKeyLookupCrossover
+{
+    const NSUInteger existingCount = 20000;
+
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < existingCount; i++ ) {
+        [artistArray addObject:@{ @"id" : @(i+1), @"name" : @"Rick Astley" }];
+    }
+
+    NSManagedObjectContext *context = [self.stack backgroundManagedObjectContext];
+    [Artist rzi_objectsFromArray:artistArray inContext:context];
+    [context performBlockAndWait:^{
+        NSError *err = nil;
+        XCTAssertTrue([context rzv_saveToStoreAndWait:&err], @"Save failed: %@", err);
+    }];
+
+    Class lookupClass = NSClassFromString(@"RZVinylPrimaryKeyLookup");
+    XCTAssertNotNil(lookupClass, @"Primary key lookup is missing");
+    NSEntityDescription *entity = [self.stack entityForClass:[Artist class]];
+    const NSUInteger chunkSize = 500;
+
+    for ( NSNumber *stride in @[@1, @2, @4] ) {
+        for ( NSNumber *keyCount in @[@1000, @5000, @10000] ) {
+            NSMutableSet *primaryValues = [NSMutableSet set];
+            for ( NSUInteger i = 0; i < keyCount.unsignedIntegerValue; i++ ) {
+                [primaryValues addObject:@(i * stride.unsignedIntegerValue + 1)];
+            }
+            const NSUInteger expectedCount = MIN(keyCount.unsignedIntegerValue, (existingCount - 1) / stride.unsignedIntegerValue + 1);
+
+            __block NSDictionary *chunkedArtists = nil;
+            __block NSDictionary *scannedArtists = nil;
+            __block NSUInteger chunkedFetchCount = 0;
+
+            __block NSUInteger scannedFetchCount = 0;
+
+            // Range scans only fetch keys and object IDs, so both lookups run keys-only
+            id chunkedLookup = [[lookupClass alloc] initWithEntity:entity primaryKey:@"remoteID" context:context keysOnly:YES chunkSize:chunkSize rangeScanThreshold:NSUIntegerMax];
+            uint64_t chunkedTime = dispatch_benchmark(3, ^{
+                [context performBlockAndWait:^{
+                    [context reset];
+                    chunkedArtists = [chunkedLookup objectsByPrimaryKeyValue:primaryValues fetchCount:&chunkedFetchCount];
+                }];
+            });
+
+            id scanningLookup = [[lookupClass alloc] initWithEntity:entity primaryKey:@"remoteID" context:context keysOnly:YES chunkSize:chunkSize rangeScanThreshold:0];
+            uint64_t scannedTime = dispatch_benchmark(3, ^{
+                [context performBlockAndWait:^{
+                    [context reset];
+                    scannedArtists = [scanningLookup objectsByPrimaryKeyValue:primaryValues fetchCount:&scannedFetchCount];
+                }];
+            });
+
+            NSLog(@"Lookup of %@ keys with stride %@ took %f s chunked, %f s with range scan when dense enough",
+                  keyCount, stride, (double)chunkedTime/NSEC_PER_SEC, (double)scannedTime/NSEC_PER_SEC);
+
+            XCTAssertEqual(chunkedFetchCount, (keyCount.unsignedIntegerValue + chunkSize - 1) / chunkSize, @"Keys should be fetched in chunks");
+            if ( stride.unsignedIntegerValue == 1 ) {
+                XCTAssertEqual(scannedFetchCount, 2, @"Dense keys should be resolved with a count and a single range scan");
+            }
+            XCTAssertEqual(chunkedArtists.count, expectedCount, @"Wrong number of artists found");
+            XCTAssertEqual(scannedArtists.count, expectedCount, @"Wrong number of artists found");
+        }
+    }
+
+    [context performBlockAndWait:^{
+        XCTAssertEqual([Artist rzv_countWhere:nil inContext:context], existingCount, @"Existing artists should not be duplicated");
+    }];
+}
+
+- (void)test_PrimaryKeyNormalization
+{
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+
+    NSArray *numericArtists = @[ @{ @"id" : @1, @"name" : @"Rick Astley" }, @{ @"id" : @2, @"name" : @"Bananarama" } ];
+    [Artist rzi_objectsFromArray:numericArtists inContext:context];
+
+    // The same artists with string IDs, mixed with a duplicate in the same payload
+    NSArray *stringArtists = @[
+        @{ @"id" : @"1", @"name" : @"Rick Astley (Remastered)" },
+        @{ @"id" : @"2", @"name" : @"Bananarama (Remastered)" },
+        @{ @"id" : @2, @"name" : @"Bananarama (Remastered)" }
+    ];
+    NSArray *artists = [Artist rzi_objectsFromArray:stringArtists inContext:context];
+    XCTAssertEqual(artists.count, 2, @"Equal keys of different types should resolve to the same object");
+    XCTAssertEqual([Artist rzv_countWhere:nil inContext:context], 2, @"String keys should not create duplicates");
+
+    artists = [Artist rzi_objectsFromArray:stringArtists inContext:context withMappings:nil options:RZVinylImportOptionsPrefetchRelationships];
+    XCTAssertEqual(artists.count, 2, @"Equal keys of different types should resolve to the same object when prefetched");
+    XCTAssertEqual([Artist rzv_countWhere:nil inContext:context], 2, @"String keys should not create duplicates when prefetched");
+
+    Artist *artist = [Artist rzv_objectWithPrimaryKeyValue:@"1" createNew:NO inContext:context];
+    XCTAssertNotNil(artist, @"Lookup by string key should find the artist");
+    XCTAssertEqualObjects(artist.remoteID, @1, @"Wrong artist found");
+    XCTAssertEqualObjects(artist.name, @"Rick Astley (Remastered)", @"String keyed values were not imported");
+}
+
+- (void)test_UniquenessConstraintUpsert
+{
+    if ( ![NSEntityDescription instancesRespondToSelector:@selector(uniquenessConstraints)] ) {
+        return;
+    }
+
+    NSManagedObjectModel *model = [self.stack.managedObjectModel copy];
+    [[model.entitiesByName objectForKey:@"Artist"] setUniquenessConstraints:@[ @[ @"remoteID" ] ]];
+
+    NSURL *storeURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:@"RZVinylUpsertTest.sqlite"];
+    [[NSFileManager defaultManager] removeItemAtURL:storeURL error:NULL];
+    RZCoreDataStack *stack = [[RZCoreDataStack alloc] initWithModel:model
+                                                          storeType:NSSQLiteStoreType
+                                                           storeURL:storeURL
+                                         persistentStoreCoordinator:nil
+                                                            options:RZCoreDataStackOptionsDeleteDatabaseIfUnreadable | RZCoreDataStackOptionsMergeByPropertyObjectTrump];
+    [RZCoreDataStack setDefaultStack:stack];
+
+    NSMutableArray *artistArray = [NSMutableArray array];
+    for ( NSUInteger i = 0; i < 100; i++ ) {
+        [artistArray addObject:@{ @"id" : @(i+1), @"name" : @"Rick Astley", @"genre" : @"Pop" }];
+    }
+
+    NSManagedObjectContext *context = [stack backgroundManagedObjectContext];
+    [Artist rzi_objectsFromArray:artistArray inContext:context];
+    [context performBlockAndWait:^{
+        NSError *err = nil;
+        XCTAssertTrue([context rzv_saveToStoreAndWait:&err], @"Save failed: %@", err);
+        [context reset];
+    }];
+
+    NSMutableArray *payload = [NSMutableArray array];
+    for ( NSDictionary *artist in artistArray ) {
+        NSMutableDictionary *updated = [artist mutableCopy];
+        updated[@"name"] = @"Rick Astley (Remastered)";
+        [payload addObject:updated];
+    }
+    [payload addObject:@{ @"id" : @1000, @"name" : @"Bananarama", @"genre" : @"Pop" }];
+
+    RZVinylImportMetrics *metrics = [[RZVinylImportMetrics alloc] init];
+    [context performBlockAndWait:^{
+        [context rzi_setImportMetrics:metrics];
+    }];
+
+    [Artist rzi_objectsFromArray:payload inContext:context withMappings:nil options:RZVinylImportOptionsUpsertUsingUniquenessConstraints];
+
+    [context performBlockAndWait:^{
+        XCTAssertEqual(metrics.lastReport.entityMetrics[@"Artist"].prefetchQueryCount, 0, @"Existing artists should not be fetched");
+
+        NSError *err = nil;
+        XCTAssertTrue([context rzv_saveToStoreAndWait:&err], @"Save failed: %@", err);
+        [context reset];
+
+        XCTAssertEqual([Artist rzv_countWhere:nil inContext:context], payload.count, @"The store should merge the existing artists");
+        Artist *artist = [Artist rzv_objectWithPrimaryKeyValue:@50 createNew:NO inContext:context];
+        XCTAssertEqualObjects(artist.name, @"Rick Astley (Remastered)", @"Imported values should win");
+    }];
+
+    [RZCoreDataStack setDefaultStack:self.stack];
+    [[NSFileManager defaultManager] removeItemAtURL:storeURL error:NULL];
+}
 
 @end
@@ -22,6 +22,35 @@
 
 #pragma mark - Utils
 
+/**
+ *  Batch requests need a SQLite store. Sets up a fresh SQLite stack as the default stack,
+ *  which is restored and deleted by -tearDownSQLiteStack:.
+ */
+- (RZCoreDataStack *)setUpSQLiteStackNamed:(NSString *)name
+{
+    NSURL *storeURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[name stringByAppendingPathExtension:@"sqlite"]];
+    [[NSFileManager defaultManager] removeItemAtURL:storeURL error:NULL];
+    RZCoreDataStack *stack = [[RZCoreDataStack alloc] initWithModel:self.stack.managedObjectModel
+                                                          storeType:NSSQLiteStoreType
+                                                           storeURL:storeURL
+                                         persistentStoreCoordinator:nil
+                                                            options:RZCoreDataStackOptionsDeleteDatabaseIfUnreadable];
+    [RZCoreDataStack setDefaultStack:stack];
+
+    NSError *err = nil;
+    [self seedDatabaseInContext:stack.mainManagedObjectContext];
+    XCTAssertTrue([stack.mainManagedObjectContext rzv_saveToStoreAndWait:&err], @"Save failed: %@", err);
+
+    return stack;
+}
+
+- (void)tearDownSQLiteStack:(RZCoreDataStack *)stack
+{
+    [RZCoreDataStack setDefaultStack:self.stack];
+    NSPersistentStore *store = [stack.persistentStoreCoordinator.persistentStores firstObject];
+    [[NSFileManager defaultManager] removeItemAtURL:store.URL error:NULL];
+}
+
 #pragma mark - Tests
 
 - (void)test_SimpleCreation
@@ -57,6 +86,47 @@
     XCTAssertEqualObjects(matchingArtist.name, @"Sergio", @"Fetched artist has wrong name");
 }
 
+- (void)test_BatchObjectTransfer
+{
+    NSManagedObjectContext *mainContext = self.stack.mainManagedObjectContext;
+    NSManagedObjectContext *bgContext = [self.stack backgroundManagedObjectContext];
+
+    __block NSArray *bgSongs = nil;
+    __block Artist *unsavedArtist = nil;
+    [bgContext performBlockAndWait:^{
+        bgSongs = [Song rzv_where:nil sort:@[RZVKeySort(@"remoteID", YES)] inContext:bgContext];
+        unsavedArtist = [Artist rzv_newObjectInContext:bgContext];
+    }];
+    XCTAssertGreaterThan(bgSongs.count, 0, @"Should be songs");
+
+    [mainContext reset];
+    NSArray *songs = [bgSongs rzv_objectsInContext:mainContext];
+    XCTAssertEqual(songs.count, bgSongs.count, @"Every song should be transferred");
+    XCTAssertEqualObjects([songs valueForKey:@"objectID"], [bgSongs valueForKey:@"objectID"], @"Songs should be in the same order");
+    for ( Song *song in songs ) {
+        XCTAssertEqual(song.managedObjectContext, mainContext, @"Wrong context");
+        XCTAssertFalse(song.isFault, @"Songs should be loaded");
+    }
+
+    NSString *firstTitle = [[songs firstObject] title];
+    [mainContext reset];
+    NSArray *faults = [[bgSongs valueForKey:@"objectID"] rzv_objectsInContext:mainContext returnsObjectsAsFaults:YES];
+    XCTAssertEqual(faults.count, bgSongs.count, @"Every song should be transferred");
+    for ( Song *song in faults ) {
+        XCTAssertTrue(song.isFault, @"Songs should be faults");
+    }
+    XCTAssertEqualObjects([[faults firstObject] title], firstTitle, @"Faults should fire");
+
+    // Unsaved objects get permanent IDs, but don't exist in other contexts
+    __block NSArray *transferred = nil;
+    [bgContext performBlockAndWait:^{
+        transferred = [@[unsavedArtist, [bgSongs firstObject]] rzv_objectsInContext:mainContext];
+        XCTAssertFalse(unsavedArtist.objectID.isTemporaryID, @"Unsaved object should have a permanent ID");
+    }];
+    XCTAssertEqual(transferred.count, 1, @"Unsaved object should be omitted");
+    XCTAssertEqualObjects([[transferred firstObject] objectID], [[bgSongs firstObject] objectID], @"Wrong object");
+}
+
 - (void)test_BackgroundBlock
 {
     __block BOOL finished = NO;
@@ -171,6 +241,53 @@
     }];
 }
 
+- (void)test_PrimaryKeyIdentityMap
+{
+    Artist *dusky = [Artist rzv_objectWithPrimaryKeyValue:@1000 createNew:NO];
+    XCTAssertNotNil(dusky, @"Should be a matching object");
+    XCTAssertEqual([Artist rzv_objectWithPrimaryKeyValue:@1000 createNew:NO], dusky, @"Should return the same instance");
+
+    Artist *pezzner = [Artist rzv_objectWithPrimaryKeyValue:@9999 createNew:YES];
+    XCTAssertEqual([Artist rzv_objectWithPrimaryKeyValue:@9999 createNew:YES], pezzner, @"Should not create a second instance");
+
+    // Re-keyed objects must not be returned for their old key
+    pezzner.remoteID = @9998;
+    XCTAssertNil([Artist rzv_objectWithPrimaryKeyValue:@9999 createNew:NO], @"Should not find re-keyed object");
+    XCTAssertEqual([Artist rzv_objectWithPrimaryKeyValue:@9998 createNew:NO], pezzner, @"Should find re-keyed object by fetch");
+
+    // Deleted objects must not be returned
+    [dusky rzv_delete];
+    [self.stack.mainManagedObjectContext processPendingChanges];
+    XCTAssertNil([Artist rzv_objectWithPrimaryKeyValue:@1000 createNew:NO], @"Should not find deleted object");
+
+    // Objects from before a reset must not be returned
+    [self.stack.mainManagedObjectContext reset];
+    Artist *resetDusky = [Artist rzv_objectWithPrimaryKeyValue:@1000 createNew:NO];
+    XCTAssertNotNil(resetDusky, @"Should find object again after reset");
+    XCTAssertNotEqual(resetDusky, dusky, @"Should not return an instance from before the reset");
+    XCTAssertEqualObjects(resetDusky.managedObjectContext, self.stack.mainManagedObjectContext, @"Wrong context");
+
+    uint64_t time = dispatch_benchmark(1000, ^{
+        [Artist rzv_objectWithPrimaryKeyValue:@1000 createNew:NO];
+    });
+    NSLog(@"Primary key lookup of a known object took %f s", (double)time/NSEC_PER_SEC);
+}
+
+- (void)test_EntityLookup
+{
+    NSEntityDescription *artistEntity = [[self.stack.managedObjectModel entitiesByName] objectForKey:@"Artist"];
+    XCTAssertEqualObjects([self.stack entityForClass:[Artist class]], artistEntity, @"Wrong entity for class");
+    XCTAssertEqualObjects([Artist rzv_entity], artistEntity, @"Wrong entity for class");
+    XCTAssertEqualObjects([Artist rzv_entityName], @"Artist", @"Wrong entity name for class");
+    XCTAssertEqual([self.stack classForEntityName:@"Song"], [Song class], @"Wrong class for entity");
+    XCTAssertNil([self.stack entityForClass:[NSString class]], @"Should not find entity for non-entity class");
+
+    uint64_t time = dispatch_benchmark(10000, ^{
+        [Artist rzv_entityName];
+    });
+    NSLog(@"Entity name lookup took %f s", (double)time/NSEC_PER_SEC);
+}
+
 - (void)test_FetchOrCreateByAttributes
 {
     Artist *dusky = [Artist rzv_objectWithAttributes:@{ @"name" : @"Dusky" } createNew:NO];
@@ -184,6 +301,47 @@
     XCTAssertTrue([pezzner.managedObjectContext hasChanges], @"Moc should have changes from new object");
 }
 
+- (void)test_FetchTemplates
+{
+    // Lookups by key must find the same objects as fetches with an equivalent predicate
+    Artist *dusky = [Artist rzv_objectWithPrimaryKeyValue:@1000 createNew:NO];
+    XCTAssertNotNil(dusky, @"Should be a matching object");
+    XCTAssertEqualObjects(dusky, [[Artist rzv_where:RZVPred(@"remoteID == %@", @1000)] firstObject], @"Primary key lookup should match the fetch");
+    XCTAssertEqualObjects([Song rzv_objectWithPrimaryKeyValue:@10931 createNew:NO], [[Song rzv_where:RZVPred(@"remoteID == %@", @10931)] firstObject], @"Primary key lookup should match the fetch");
+    XCTAssertNil([Artist rzv_objectWithPrimaryKeyValue:@1 createNew:NO], @"Should be no matching object");
+
+    XCTAssertEqualObjects([Artist rzv_objectWithAttributes:@{ @"name" : @"Dusky" } createNew:NO], [[Artist rzv_where:RZVPred(@"name == %@", @"Dusky")] firstObject], @"Single key lookup should match the fetch");
+    XCTAssertEqual([Artist rzv_objectWithAttributes:@{ @"name" : @"Dusky", @"genre" : @"Deep House" } createNew:NO], dusky, @"Should be a matching object");
+    XCTAssertEqual([Artist rzv_objectWithAttributes:@{ @"genre" : @"Deep House", @"name" : @"Dusky" } createNew:NO], dusky, @"Key order should not matter");
+    XCTAssertEqual([Song rzv_objectWithAttributes:@{ @"title" : @"Lateralus", @"artist.name" : @"Tool" } createNew:NO],
+                   [[Song rzv_where:RZVPred(@"title == %@ AND artist.name == %@", @"Lateralus", @"Tool")] firstObject], @"Key path lookup should match the fetch");
+    XCTAssertNil([Artist rzv_objectWithAttributes:@{ @"name" : @"Dusky", @"genre" : @"Polka" } createNew:NO], @"All values should be matched");
+
+    // NSNull only matches nil
+    Artist *unknown = [Artist rzv_newObject];
+    unknown.remoteID = @5000;
+    unknown.name = @"Dusky";
+    XCTAssertTrue([self.stack.mainManagedObjectContext rzv_saveToStoreAndWait:NULL], @"Save failed");
+
+    XCTAssertEqual([Artist rzv_objectWithAttributes:@{ @"name" : @"Dusky", @"genre" : [NSNull null] } createNew:NO], unknown, @"NSNull should match nil");
+    XCTAssertEqualObjects(unknown, [[Artist rzv_where:RZVPred(@"name == %@ AND genre == nil", @"Dusky")] firstObject], @"NSNull lookup should match the fetch");
+    XCTAssertNil([Artist rzv_objectWithAttributes:@{ @"name" : @"BCee", @"genre" : [NSNull null] } createNew:NO], @"NSNull should not match a value");
+
+    // Template lookups against fetches that parse a predicate format string on every call
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+    uint64_t templateTime = dispatch_benchmark(1000, ^{
+        [Artist rzv_objectWithAttributes:@{ @"name" : @"Dusky", @"genre" : @"Deep House" } createNew:NO];
+    });
+    uint64_t formatTime = dispatch_benchmark(1000, ^{
+        NSFetchRequest *fetch = [NSFetchRequest fetchRequestWithEntityName:@"Artist"];
+        fetch.predicate = [NSPredicate predicateWithFormat:@"name == %@ AND genre == %@", @"Dusky", @"Deep House"];
+        fetch.fetchLimit = 1;
+        [[context executeFetchRequest:fetch error:NULL] lastObject];
+    });
+
+    NSLog(@"Lookup by attributes took %f s with templates, %f s with format strings", (double)templateTime/NSEC_PER_SEC, (double)formatTime/NSEC_PER_SEC);
+}
+
 - (void)test_FetchAll
 {
     // Get all artists
@@ -274,6 +432,156 @@
     XCTAssertEqual([[artists lastObject] managedObjectContext], scratchContext, @"Wrong Context");
 }
 
+- (void)test_Prefetching
+{
+    NSManagedObjectContext *context = self.stack.mainManagedObjectContext;
+
+    [context reset];
+    NSArray *artists = [Artist rzv_where:nil sort:nil prefetching:@[] returnsObjectsAsFaults:YES];
+    XCTAssertEqual(artists.count, 3, @"Should be three artists");
+    for ( Artist *artist in artists ) {
+        XCTAssertTrue([artist hasFaultForRelationshipNamed:@"songs"], @"Songs should not be prefetched");
+    }
+
+    [context reset];
+    artists = [Artist rzv_where:nil sort:nil prefetching:@[@"songs"] returnsObjectsAsFaults:NO];
+    XCTAssertEqual(artists.count, 3, @"Should be three artists");
+    for ( Artist *artist in artists ) {
+        XCTAssertFalse(artist.isFault, @"Artists should not be faults");
+        XCTAssertFalse([artist hasFaultForRelationshipNamed:@"songs"], @"Songs should be prefetched");
+    }
+
+    // The class default applies to the other fetch methods and to fetched results controllers
+    [context reset];
+    for ( Artist *artist in [Artist rzv_all] ) {
+        XCTAssertFalse([artist hasFaultForRelationshipNamed:@"songs"], @"Songs should be prefetched by default");
+    }
+
+    NSFetchedResultsController *frc = [NSFetchedResultsController rzv_forEntity:@"Artist" inContext:context where:nil sort:@[RZVKeySort(@"name", YES)]];
+    XCTAssertEqualObjects(frc.fetchRequest.relationshipKeyPathsForPrefetching, @[@"songs"], @"Controller should prefetch the class default");
+
+    frc = [NSFetchedResultsController rzv_forEntity:@"Artist"
+                                          inContext:context
+                                              where:nil
+                                               sort:@[RZVKeySort(@"name", YES)]
+                                        prefetching:@[]
+                             returnsObjectsAsFaults:NO
+                                 sectionNameKeyPath:nil
+                                          cacheName:nil];
+    XCTAssertEqual(frc.fetchRequest.relationshipKeyPathsForPrefetching.count, 0, @"Controller should not prefetch");
+    XCTAssertFalse(frc.fetchRequest.returnsObjectsAsFaults, @"Controller should not return faults");
+}
+
+- (void)test_EnumerateWhere
+{
+    NSUInteger songCount = [Song rzv_count];
+    XCTAssertGreaterThan(songCount, 2, @"There should be songs to enumerate");
+
+    __block NSUInteger enumeratedCount = 0;
+    __block NSNumber *lastRemoteID = nil;
+    [Song rzv_enumerateWhere:nil sort:@[RZVKeySort(@"remoteID", YES)] batchSize:2 usingBlock:^(Song *song, BOOL *stop) {
+        XCTAssertFalse(song.isFault, @"Objects should be loaded while they are enumerated");
+        if ( lastRemoteID != nil ) {
+            XCTAssertEqual([lastRemoteID compare:song.remoteID], NSOrderedAscending, @"Objects should be enumerated in order");
+        }
+        lastRemoteID = song.remoteID;
+        enumeratedCount++;
+    }];
+    XCTAssertEqual(enumeratedCount, songCount, @"Every song should be enumerated");
+
+    __block Song *firstSong = nil;
+    enumeratedCount = 0;
+    [Song rzv_enumerateWhere:nil sort:nil batchSize:2 usingBlock:^(Song *song, BOOL *stop) {
+        firstSong = firstSong ?: song;
+        enumeratedCount++;
+        *stop = ( enumeratedCount == 1 );
+    }];
+    XCTAssertEqual(enumeratedCount, 1, @"Enumeration should stop early");
+    XCTAssertTrue(firstSong.isFault, @"Enumerated objects should be turned back into faults");
+}
+
+- (void)test_Projections
+{
+    // Dictionary results are only fetched from SQLite stores without unsaved changes
+    RZCoreDataStack *stack = [self setUpSQLiteStackNamed:@"RZVinylProjectionTest"];
+
+    NSArray *sort = @[RZVKeySort(@"remoteID", YES)];
+    NSArray *songs = [Song rzv_where:nil sort:sort];
+    XCTAssertGreaterThan(songs.count, 0, @"Should be songs");
+
+    NSArray *values = [Song rzv_valuesForKeys:@[@"remoteID", @"title", @"artist.name"] where:nil sort:sort];
+    XCTAssertEqual(values.count, songs.count, @"Should be values for every song");
+    [songs enumerateObjectsUsingBlock:^(Song *song, NSUInteger idx, BOOL *stop) {
+        XCTAssertEqualObjects(values[idx][@"remoteID"], song.remoteID, @"Wrong remote ID");
+        XCTAssertEqualObjects(values[idx][@"title"], song.title, @"Wrong title");
+        XCTAssertEqualObjects(values[idx][@"artist.name"], song.artist.name, @"Wrong artist name");
+    }];
+
+    NSArray *objectIDs = [Song rzv_objectIDsWhere:nil sort:sort];
+    XCTAssertEqualObjects(objectIDs, [songs valueForKey:@"objectID"], @"Wrong object IDs");
+
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"artist.remoteID == 2399"];
+    XCTAssertEqual([Song rzv_objectIDsWhere:predicate sort:nil].count, [Song rzv_countWhere:predicate], @"Wrong number of filtered object IDs");
+
+    // Unsaved objects are included
+    Song *newSong = [Song rzv_newObject];
+    newSong.remoteID = @999999;
+    newSong.title = @"Unsaved";
+
+    values = [Song rzv_valuesForKeys:@[@"remoteID", @"title"] where:nil sort:sort];
+    XCTAssertEqual(values.count, songs.count + 1, @"Unsaved song should be included");
+    XCTAssertEqualObjects([values lastObject], (@{ @"remoteID" : @999999, @"title" : @"Unsaved" }), @"Wrong values for unsaved song");
+
+    objectIDs = [Song rzv_objectIDsWhere:nil sort:sort];
+    XCTAssertEqualObjects([objectIDs lastObject], newSong.objectID, @"Unsaved song should be included");
+
+    [self tearDownSQLiteStack:stack];
+}
+
+- (void)test_AsyncFetch
+{
+    XCTestExpectation *fetchDone = [self expectationWithDescription:@"Async fetch complete"];
+    NSProgress *progress = [Artist rzv_asyncWhere:RZVPred(@"genre != nil") sort:@[RZVKeySort(@"name", YES)] completion:^(NSArray *results, NSError *error) {
+        XCTAssertTrue([NSThread isMainThread], @"Results should be delivered on the main thread");
+        XCTAssertNil(error, @"Fetch failed: %@", error);
+        XCTAssertEqualObjects(results, [Artist rzv_where:RZVPred(@"genre != nil") sort:@[RZVKeySort(@"name", YES)]], @"Wrong results");
+        [fetchDone fulfill];
+    }];
+    XCTAssertNotNil(progress, @"A progress should be returned");
+
+    XCTestExpectation *cancelDone = [self expectationWithDescription:@"Async fetch cancelled"];
+    progress = [Artist rzv_asyncWhere:nil sort:nil completion:^(NSArray *results, NSError *error) {
+        XCTAssertNil(results, @"A cancelled fetch should not return results");
+        XCTAssertEqual(error.code, NSUserCancelledError, @"A cancelled fetch should complete with a cancellation error");
+        [cancelDone fulfill];
+    }];
+    [progress cancel];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    if ( NSClassFromString(@"NSAsynchronousFetchRequest") == Nil ) {
+        return;
+    }
+
+    // With a SQLite store the fetch runs in the coordinator
+    RZCoreDataStack *stack = [self setUpSQLiteStackNamed:@"RZVinylAsyncFetchTest"];
+    XCTestExpectation *storeFetchDone = [self expectationWithDescription:@"Async store fetch complete"];
+    NSArray *titleSort = @[RZVKeySort(@"title", YES)];
+    [Song rzv_asyncWhere:RZVPred(@"artist.remoteID == 2399") sort:titleSort completion:^(NSArray *results, NSError *error) {
+        XCTAssertNil(error, @"Fetch failed: %@", error);
+        XCTAssertEqual(results.count, [Song rzv_countWhere:RZVPred(@"artist.remoteID == 2399")], @"Wrong number of results");
+        XCTAssertEqual([[results firstObject] managedObjectContext], stack.mainManagedObjectContext, @"Results should be in the main context");
+        XCTAssertEqualObjects(results, [results sortedArrayUsingDescriptors:titleSort], @"Results should keep the fetch's sort order");
+        for ( Song *song in results ) {
+            XCTAssertFalse(song.isFault, @"Results should be loaded, not faults");
+        }
+        [storeFetchDone fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    [self tearDownSQLiteStack:stack];
+}
+
 - (void)test_Count
 {
     NSUInteger artistCount = [Artist rzv_count];
@@ -283,6 +591,48 @@
     XCTAssertEqual(artistsWithSongsCount, 2, @"Should be two artists with songs");
 }
 
+- (void)test_Aggregates
+{
+    // In-memory stores are aggregated in memory, SQLite stores by the store
+    RZCoreDataStack *stack = nil;
+    for ( NSUInteger pass = 0; pass < 2; pass++ ) {
+        if ( pass == 1 ) {
+            stack = [self setUpSQLiteStackNamed:@"RZVinylAggregateTest"];
+        }
+
+        NSArray *songs = [Song rzv_all];
+        XCTAssertEqualObjects([Song rzv_sumOf:@"length" where:nil], [songs valueForKeyPath:@"@sum.length"], @"Wrong sum");
+        XCTAssertEqualObjects([Song rzv_minOf:@"length" where:nil], [songs valueForKeyPath:@"@min.length"], @"Wrong min");
+        XCTAssertEqualObjects([Song rzv_maxOf:@"length" where:nil], [songs valueForKeyPath:@"@max.length"], @"Wrong max");
+        XCTAssertEqualWithAccuracy([[Song rzv_averageOf:@"length" where:nil] doubleValue], [[songs valueForKeyPath:@"@avg.length"] doubleValue], 0.001, @"Wrong average");
+
+        NSPredicate *predicate = [NSPredicate predicateWithFormat:@"artist.remoteID == 2399"];
+        NSArray *filteredSongs = [Song rzv_where:predicate];
+        XCTAssertEqualObjects([Song rzv_sumOf:@"length" where:predicate], [filteredSongs valueForKeyPath:@"@sum.length"], @"Wrong filtered sum");
+
+        NSCountedSet *genres = [NSCountedSet setWithArray:[songs valueForKeyPath:@"artist.genre"]];
+        [genres removeObject:[NSNull null]];
+        NSDictionary *genreCounts = [Song rzv_countGroupedBy:@"artist.genre" where:nil];
+        XCTAssertEqual(genreCounts.count, genres.count, @"Wrong number of groups");
+        for ( NSString *genre in genres ) {
+            XCTAssertEqual([genreCounts[genre] unsignedIntegerValue], [genres countForObject:genre], @"Wrong count for %@", genre);
+        }
+
+        NSPredicate *nothing = [NSPredicate predicateWithValue:NO];
+        XCTAssertEqualObjects([Song rzv_sumOf:@"length" where:nothing], @0, @"Sum of no objects should be zero");
+        XCTAssertNil([Song rzv_maxOf:@"length" where:nothing], @"Max of no objects should be nil");
+        XCTAssertEqual([Song rzv_countGroupedBy:@"artist.genre" where:nothing].count, 0, @"Should be no groups");
+
+        // Unsaved changes are included
+        Song *song = [songs firstObject];
+        song.length = @([song.length integerValue] + 1000);
+        XCTAssertEqual([[Song rzv_sumOf:@"length" where:nil] integerValue], [[songs valueForKeyPath:@"@sum.length"] integerValue], @"Sum should include unsaved changes");
+        [song.managedObjectContext rollback];
+    }
+
+    [self tearDownSQLiteStack:stack];
+}
+
 - (void)test_Delete
 {
     Artist *dusky = [Artist rzv_objectWithPrimaryKeyValue:@1000 createNew:NO];
@@ -428,6 +778,93 @@
     }];
 }
 
+- (void)test_BatchDelete
+{
+    if ( NSClassFromString(@"NSBatchDeleteRequest") == Nil ) {
+        return;
+    }
+
+    RZCoreDataStack *stack = [self setUpSQLiteStackNamed:@"RZVinylBatchDeleteTest"];
+    NSManagedObjectContext *context = stack.mainManagedObjectContext;
+    NSError *err = nil;
+
+    Artist *tool = [Artist rzv_objectWithPrimaryKeyValue:@2399 createNew:NO inContext:context];
+    NSUInteger toolSongCount = tool.songs.count;
+    NSUInteger songCount = [Song rzv_countWhere:nil inContext:context];
+    XCTAssertGreaterThan(toolSongCount, 0, @"Tool should have songs");
+
+    // Songs only have to-one nullify relationships, so they are deleted in the store
+    NSArray *deletedIDs = [Song rzv_batchDeleteAllWhere:RZVPred(@"artist.remoteID == 2399") inContext:context error:&err];
+    XCTAssertNotNil(deletedIDs, @"Batch delete failed: %@", err);
+    XCTAssertEqual(deletedIDs.count, toolSongCount, @"Wrong number of songs deleted");
+    XCTAssertFalse(context.hasChanges, @"The songs should be deleted in the store, not the context");
+    XCTAssertEqual([Song rzv_countWhere:nil inContext:context], songCount - toolSongCount, @"Deleted songs should be merged into the main context");
+
+    __block NSUInteger topLevelSongCount = 0;
+    NSManagedObjectContext *topLevelContext = [stack valueForKey:@"topLevelBackgroundContext"];
+    [topLevelContext performBlockAndWait:^{
+        topLevelSongCount = [Song rzv_countWhere:nil inContext:topLevelContext];
+    }];
+    XCTAssertEqual(topLevelSongCount, songCount - toolSongCount, @"Deleted songs should be merged into the top level context");
+
+    // Unsaved changes to songs in the context would be lost by a store delete, so they are deleted through the context
+    Artist *dusky = [Artist rzv_objectWithPrimaryKeyValue:@1000 createNew:NO inContext:context];
+    NSUInteger duskySongCount = dusky.songs.count;
+    XCTAssertGreaterThan(duskySongCount, 0, @"Dusky should have songs");
+    [[dusky.songs anyObject] setTitle:@"Unsaved Title"];
+
+    deletedIDs = [Song rzv_batchDeleteAllWhere:RZVPred(@"artist.remoteID == 1000") inContext:context error:&err];
+    XCTAssertEqual(deletedIDs.count, duskySongCount, @"Wrong number of songs deleted");
+    XCTAssertEqual(context.deletedObjects.count, duskySongCount, @"Songs should be deleted in the context");
+    XCTAssertTrue([context rzv_saveToStoreAndWait:&err], @"Save failed: %@", err);
+
+    // Artists cascade to their songs, so they are deleted through the context
+    deletedIDs = [Artist rzv_batchDeleteAllWhere:nil inContext:context error:&err];
+    XCTAssertEqual(deletedIDs.count, 3, @"Wrong number of artists deleted");
+    XCTAssertTrue(context.hasChanges, @"Artists should be deleted in the context");
+    XCTAssertTrue([context rzv_saveToStoreAndWait:&err], @"Save failed: %@", err);
+    XCTAssertEqual([Song rzv_countWhere:nil inContext:context], 0, @"Songs should be deleted by the cascade rule");
+
+    [self tearDownSQLiteStack:stack];
+}
+
+- (void)test_UpdateAll
+{
+    NSDate *now = [NSDate date];
+    NSPredicate *toolSongs = RZVPred(@"artist.remoteID == 2399");
+    NSUInteger toolSongCount = [Song rzv_countWhere:toolSongs];
+
+    // The in-memory store can't batch update, so the objects are updated in the context
+    NSError *err = nil;
+    NSArray *updatedIDs = [Song rzv_updateAllWhere:toolSongs setValues:@{ @"lastUpdated" : now } inContext:self.stack.mainManagedObjectContext error:&err];
+    XCTAssertNotNil(updatedIDs, @"Update failed: %@", err);
+    XCTAssertEqual(updatedIDs.count, toolSongCount, @"Wrong number of songs updated");
+    XCTAssertEqual([Song rzv_countWhere:RZVPred(@"lastUpdated == %@", now)], toolSongCount, @"Songs should have the new value");
+
+    if ( NSClassFromString(@"NSBatchDeleteRequest") == Nil ) {
+        return;
+    }
+
+    RZCoreDataStack *stack = [self setUpSQLiteStackNamed:@"RZVinylBatchUpdateTest"];
+    NSManagedObjectContext *context = stack.mainManagedObjectContext;
+
+    // Registered objects should be refreshed with the stored values
+    Song *song = [[Song rzv_where:toolSongs inContext:context] firstObject];
+    XCTAssertNil(song.lastUpdated, @"Seeded songs should not have a date");
+
+    updatedIDs = [Song rzv_updateAllWhere:toolSongs setValues:@{ @"lastUpdated" : now } inContext:context error:&err];
+    XCTAssertNotNil(updatedIDs, @"Batch update failed: %@", err);
+    XCTAssertEqual(updatedIDs.count, toolSongCount, @"Wrong number of songs updated");
+    XCTAssertFalse(context.hasChanges, @"The songs should be updated in the store, not the context");
+    XCTAssertEqualObjects(song.lastUpdated, now, @"Registered songs should be refreshed");
+
+    updatedIDs = [Song rzv_updateAllWhere:toolSongs setValues:@{ @"lastUpdated" : [NSNull null] } inContext:context error:&err];
+    XCTAssertEqual(updatedIDs.count, toolSongCount, @"Wrong number of songs updated");
+    XCTAssertNil(song.lastUpdated, @"NSNull should clear the value");
+
+    [self tearDownSQLiteStack:stack];
+}
+
 - (void)test_PurgeStale
 {
     __block BOOL finished = NO;
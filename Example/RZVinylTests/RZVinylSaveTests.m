@@ -10,6 +10,13 @@
 #import "Artist.h"
 #import "RZWaiter.h"
 
+// Private save helpers
+@interface NSManagedObjectContext (RZVinylSaveTesting)
+
+- (BOOL)rzv_parentContextsHaveChanges;
+
+@end
+
 @interface RZVinylSaveTests : XCTestCase
 
 @property (nonatomic, strong) RZCoreDataStack *coreDataStack;
@@ -148,4 +155,43 @@
                }];
 }
 
+- (void)testParentContextChangesWithoutBlocking
+{
+    NSManagedObjectContext *mainContext = self.coreDataStack.mainManagedObjectContext;
+    NSManagedObjectContext *childContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    childContext.parentContext = mainContext;
+
+    // The main thread waits on the child, so the child must not wait on the main context
+    __block BOOL parentsHaveChanges = YES;
+    [childContext performBlockAndWait:^{
+        parentsHaveChanges = [childContext rzv_parentContextsHaveChanges];
+    }];
+    XCTAssertFalse(parentsHaveChanges, @"New parent contexts should not have changes");
+
+    Artist *artist = [NSEntityDescription insertNewObjectForEntityForName:@"Artist" inManagedObjectContext:mainContext];
+    artist.remoteID = @1;
+    artist.name = @"Frank Zappa";
+    [mainContext processPendingChanges];
+
+    [childContext performBlockAndWait:^{
+        parentsHaveChanges = [childContext rzv_parentContextsHaveChanges];
+    }];
+    XCTAssertTrue(parentsHaveChanges, @"Unsaved changes in the main context should be seen");
+
+    NSError *err = nil;
+    XCTAssertTrue([mainContext rzv_saveToStoreAndWait:&err], @"Error saving context: %@", err);
+
+    [childContext performBlockAndWait:^{
+        parentsHaveChanges = [childContext rzv_parentContextsHaveChanges];
+    }];
+    XCTAssertFalse(parentsHaveChanges, @"Saved parent contexts should not have changes");
+
+    // The child wasn't created by the stack, so its state is unknown
+    NSManagedObjectContext *grandchildContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    grandchildContext.parentContext = childContext;
+    [grandchildContext performBlockAndWait:^{
+        XCTAssertTrue([grandchildContext rzv_parentContextsHaveChanges], @"Contexts not created by the stack should be assumed to have changes");
+    }];
+}
+
 @end
@@ -29,12 +29,33 @@
 
 @import CoreData;
 #import "RZVCompatibility.h"
+#import "NSManagedObjectContext+RZImport.h"
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wauto-import"
 #import <RZImport/NSObject+RZImport.h>
 #pragma clang diagnostic pop
 
+/**
+ *  Error domain for errors produced by RZVinyl imports.
+ */
+OBJC_EXTERN NSString* const RZVinylImportErrorDomain;
+
+typedef NS_ENUM(NSInteger, RZVinylImportError) {
+    /**
+     *  The JSON being imported is malformed, or is not a top-level array.
+     */
+    RZVinylImportErrorInvalidJSON = 1
+};
+
+/**
+ *  Block called after each chunk of a chunked import is saved.
+ *
+ *  @param importedCount The number of objects imported and saved so far.
+ *  @param totalCount    The total number of objects to import, or @p NSNotFound if it is not known up front.
+ *  @param stop          Set to YES to stop importing after the current chunk.
+ */
+typedef void (^RZVinylImportProgressBlock)(NSUInteger importedCount, NSUInteger totalCount, BOOL* RZCNonnull stop);
 
 /**
  *  Automatic importing of dictionary representations (e.g. deserialized JSON response) 
@@ -130,6 +151,164 @@
                                   inContext:(NSManagedObjectContext* RZCNonnull)context
                                withMappings:(RZVKeyMap* RZCNullable)mappings;
 
+/**
+ *  Creates or updates multiple objects in the provided managed object context using the key/value pairs in the dictionaries
+ *  in the provided array, using the provided import options.
+ *
+ *  @param array    An array of @p NSDictionary instances representing objects to be inserted/updated.
+ *  @param context  The context in which to find/insert the object. Must not be nil.
+ *  @param mappings An optional dictionary of extra mappings from keys to property names to
+ *                  use in the import. These will override/supplement implicit mappings and mappings
+ *                  provided by @p RZImportable.
+ *  @param options  Options for the import.
+ *
+ *  @note This method does not save the context or the core data stack.
+ *
+ *  @see @p RZVinylImportOptions
+ *
+ *  @return An array matching or newly created objects updated from the key/value pairs in the dictionaries in the array.
+ */
++ (NSArray* RZCNonnull)rzi_objectsFromArray:(RZVArrayOfStringDict * RZCNonnull)array
+                                  inContext:(NSManagedObjectContext* RZCNonnull)context
+                               withMappings:(RZVKeyMap* RZCNullable)mappings
+                                    options:(RZVinylImportOptions)options;
+
+
+/** @name Full Sync */
+
+
+/**
+ *  Treats the array as an authoritative snapshot: creates or updates an object for each dictionary, exactly as
+ *  @p +rzi_objectsFromArray:inContext:withMappings:options: does, and then deletes every existing object of the
+ *  receiver's entity whose primary key is not in the array.
+ *
+ *  @param array    An array of @p NSDictionary instances representing every object that should exist.
+ *  @param context  The context in which to find/insert/delete the objects. Must not be nil.
+ *  @param mappings An optional dictionary of extra mappings from keys to property names to use in the import.
+ *  @param options  Options for the import.
+ *  @param scope    An optional predicate limiting which existing objects may be deleted, for snapshots that only
+ *                  cover part of the entity (for instance, the songs of a single artist). Pass nil to consider every object.
+ *  @param error    Optional NSError pointer that will be filled in if there is an error saving the import or deleting
+ *                  the missing objects.
+ *
+ *  @note The imported objects are saved to the persistent store, along with any other changes in the context and its
+ *        ancestors, before any missing object is deleted. If the save fails, nothing is deleted.
+ *
+ *  @note Missing objects are found by object ID and are not loaded into the context. When the store is SQLite and the
+ *        entity has no relationships (whose delete rules must be applied), they are removed with batch deletes by
+ *        object ID directly in the store, and the deletions are merged into the context and the stack's main context.
+ *        Otherwise they are deleted from the context as faults, and saved.
+ *
+ *  @return The imported objects, or nil if there was an error saving the import or deleting the missing objects.
+ */
++ (NSArray* RZCNullable)rzi_syncObjectsFromArray:(RZVArrayOfStringDict* RZCNonnull)array
+                                       inContext:(NSManagedObjectContext* RZCNonnull)context
+                                    withMappings:(RZVKeyMap* RZCNullable)mappings
+                                         options:(RZVinylImportOptions)options
+                                           scope:(NSPredicate* RZCNullable)scope
+                                           error:(NSError* __autoreleasing RZCNonnull * RZCNullable)error;
+
+
+/** @name Large Imports */
+
+
+/**
+ *  Imports a large array of dictionaries in chunks, keeping memory usage bounded by the chunk size rather than the size of the array.
+ *  Each chunk is imported, saved all the way to the persistent store, and then the objects registered in the context are turned
+ *  back into faults so their row data can be released before the next chunk is imported.
+ *
+ *  @param array     An array of @p NSDictionary instances representing objects to be inserted/updated.
+ *  @param context   The context in which to find/insert the objects. Must not be nil, and must not have thread confinement.
+ *  @param mappings  An optional dictionary of extra mappings from keys to property names to use in the import.
+ *  @param options   Options for the import of each chunk.
+ *  @param chunkSize The number of dictionaries to import before each save. Must be greater than zero.
+ *  @param objectIDs Optional pointer that will be filled in with the object IDs of the imported objects. Pass NULL to avoid collecting them.
+ *  @param progress  Optional block called after each chunk is saved.
+ *  @param error     Optional NSError pointer that will be filled in if there is an error saving a chunk.
+ *
+ *  @note Unlike the other import methods, this method saves the context and all of its parent contexts after every chunk,
+ *        so any other unsaved changes in those contexts will also be saved.
+ *
+ *  @note Objects that are shared between chunks (for instance, imported via a relationship) are uniqued across chunks
+ *        by primary key, as with any other import.
+ *
+ *  @return YES if every chunk was imported and saved (or the import was stopped by the progress block), NO otherwise.
+ */
++ (BOOL)rzi_importObjectsFromArray:(RZVArrayOfStringDict* RZCNonnull)array
+                         inContext:(NSManagedObjectContext* RZCNonnull)context
+                      withMappings:(RZVKeyMap* RZCNullable)mappings
+                           options:(RZVinylImportOptions)options
+                         chunkSize:(NSUInteger)chunkSize
+                         objectIDs:(RZGeneric(NSArray, NSManagedObjectID *)* __autoreleasing RZCNullable * RZCNullable)objectIDs
+                          progress:(RZVinylImportProgressBlock RZCNullable)progress
+                             error:(NSError* __autoreleasing RZCNonnull * RZCNullable)error;
+
+/**
+ *  Imports the elements of a JSON array read incrementally from a stream. Elements are deserialized one at a time
+ *  on a background queue and imported in batches on the context's queue, so parsing overlaps with importing
+ *  and memory usage depends on the batch size rather than the size of the payload.
+ *
+ *  @param stream     An unopened input stream containing a JSON array of objects representing objects to be inserted/updated.
+ *  @param context    The context in which to find/insert the objects. Must not be nil, and must not have thread confinement.
+ *  @param mappings   An optional dictionary of extra mappings from keys to property names to use in the import.
+ *  @param options    Options for the import of each batch.
+ *  @param batchSize  The number of elements to import before each save. Must be greater than zero.
+ *  @param progress   Optional block called on the context's queue after each batch is saved. The total count is always @p NSNotFound.
+ *  @param completion Optional block called on the main thread once the import finishes, with the number of objects
+ *                    imported and any error that occurred reading the stream or saving a batch.
+ *
+ *  @note As with @p +rzi_importObjectsFromArray:inContext:withMappings:options:chunkSize:objectIDs:progress:error:,
+ *        the context and all of its parent contexts are saved after every batch.
+ */
++ (void)rzi_importObjectsFromJSONStream:(NSInputStream* RZCNonnull)stream
+                              inContext:(NSManagedObjectContext* RZCNonnull)context
+                           withMappings:(RZVKeyMap* RZCNullable)mappings
+                                options:(RZVinylImportOptions)options
+                              batchSize:(NSUInteger)batchSize
+                               progress:(RZVinylImportProgressBlock RZCNullable)progress
+                             completion:(void (^ RZCNullable)(NSUInteger importedCount, NSError* RZCNullable error))completion;
+
+/**
+ *  Imports the elements of a JSON array read incrementally from a file.
+ *
+ *  @see @p +rzi_importObjectsFromJSONStream:inContext:withMappings:options:batchSize:progress:completion:
+ */
++ (void)rzi_importObjectsFromJSONFileURL:(NSURL* RZCNonnull)fileURL
+                               inContext:(NSManagedObjectContext* RZCNonnull)context
+                            withMappings:(RZVKeyMap* RZCNullable)mappings
+                                 options:(RZVinylImportOptions)options
+                               batchSize:(NSUInteger)batchSize
+                                progress:(RZVinylImportProgressBlock RZCNullable)progress
+                              completion:(void (^ RZCNullable)(NSUInteger importedCount, NSError* RZCNullable error))completion;
+
+
+/** @name Parallel Imports */
+
+
+/**
+ *  Imports an array of dictionaries in parallel, using the default context provided by calling @p +rzv_coreDataStack
+ *  on the managed object subclass. The array is partitioned by primary key into shards, and each shard is imported
+ *  in chunks and saved on its own private queue context attached directly to the persistent store coordinator.
+ *  Since every object with a given primary key value lands in the same shard, no two contexts can create the same object.
+ *  Objects nested in the dictionaries' relationships may be shared by dictionaries in different shards, so those
+ *  that have a primary key value are imported and saved serially, before the shards are imported. Unless the stack
+ *  configures a merge policy, conflicting shard saves are resolved in favor of the shard being saved.
+ *
+ *  @param array      An array of @p NSDictionary instances representing objects to be inserted/updated.
+ *  @param mappings   An optional dictionary of extra mappings from keys to property names to use in the import.
+ *  @param options    Options for the import of each shard.
+ *  @param shardCount The number of contexts to import with in parallel. Pass zero to use one per active processor.
+ *  @param completion Optional block called on the main thread once every shard has been saved, with the first error
+ *                    that occurred saving the nested objects or a shard, if any.
+ *
+ *  @note Each save is merged into the stack's top level context and main context as it happens.
+ */
++ (void)rzi_importObjectsFromArray:(RZVArrayOfStringDict* RZCNonnull)array
+                      withMappings:(RZVKeyMap* RZCNullable)mappings
+                           options:(RZVinylImportOptions)options
+                        shardCount:(NSUInteger)shardCount
+                        completion:(void (^ RZCNullable)(NSError* RZCNullable error))completion;
+
 
 /** @name RZImportable Protocol */
 
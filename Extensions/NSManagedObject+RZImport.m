@@ -34,10 +34,36 @@
 #import "NSManagedObject+RZImportableSubclass.h"
 #import "NSManagedObject+RZVinylRecord_private.h"
 #import "NSManagedObjectContext+RZImport.h"
+#import "NSManagedObjectContext+RZVinylSave.h"
 #import "NSFetchRequest+RZVinylRecord.h"
+#import "RZCoreDataStack_private.h"
 #import "RZVinylRelationshipInfo.h"
+#import "RZVinylImportSession.h"
+#import "RZVinylJSONStreamReader.h"
+#import "RZVinylImportPlan.h"
+#import "RZVinylImportMetrics_private.h"
+#import "RZVinylIdentityMap.h"
 #import "RZVinylDefines.h"
 
+NSString* const RZVinylImportErrorDomain = @"RZVinylImportErrorDomain";
+
+// Number of parsed batches allowed to wait for the context before the reader stops parsing
+static const long kRZVinylMaxPendingStreamBatches = 2;
+
+static inline BOOL RZVImportValuesAreEqual(id value, id otherValue)
+{
+    if ( value == [NSNull null] ) {
+        value = nil;
+    }
+    if ( otherValue == [NSNull null] ) {
+        otherValue = nil;
+    }
+    return ( value == otherValue || [value isEqual:otherValue] );
+}
+
+// Number of objects each shard of a parallel import saves at a time
+static const NSUInteger kRZVinylParallelImportChunkSize = 500;
+
 //
 // Implementation
 //
@@ -59,7 +85,16 @@
 + (NSArray *)rzi_optimizedObjectsFromArray:(NSArray *)array withMappings:(NSDictionary *)mappings
 {
     NSManagedObjectContext *context = [NSManagedObjectContext rzi_currentThreadImportContext];
-    mappings = [self rzi_primaryKeyMappingsDictWithMappings:mappings];
+    RZVinylImportSession *session = [RZVinylImportSession currentSession];
+    RZVinylImportPlan *plan = [self rzi_importPlanWithMappings:mappings inContext:context];
+    mappings = plan.mappings;
+
+    [session.metrics beginImportOfEntityNamed:plan.entityName];
+    if ( session.importDepth == 0 && [session hasOptionsSet:RZVinylImportOptionsPrefetchRelationships] ) {
+        [self rzi_prefetchObjectGraphForArray:array inContext:context];
+    }
+    session.importDepth += 1;
+
     NSArray *objects = nil;
 
     if ( array.count == 1 ) {
@@ -68,17 +103,20 @@
             objects = @[importedObject];
         }
     }
-    else if ( [self rzv_primaryKey] != nil ) {
+    else if ( plan.primaryKey != nil ) {
     
         NSMutableDictionary *updatedObjects = [NSMutableDictionary dictionary];
         
-        NSString *externalPrimaryKey = [self rzv_externalPrimaryKey] ?: [self rzv_primaryKey];
+        NSString *entityName = plan.entityName;
+        NSString *primaryKey = plan.primaryKey;
+        NSString *externalPrimaryKey = plan.externalPrimaryKey;
+        RZVinylIdentityMap *identityMap = [RZVinylIdentityMap identityMapForContext:context];
         
         // Pre-fetch all objects that have a primary key in the set of objects being imported
         NSDictionary *existingObjectsByID = [self rzi_existingObjectsByIDForArray:array inContext:context];
         [array enumerateObjectsUsingBlock:^(NSDictionary *rawDict, NSUInteger idx, BOOL *stop) {
             id importedObject = nil;
-            id primaryValue = [rawDict objectForKey:externalPrimaryKey];
+            id primaryValue = [plan normalizedPrimaryKeyValue:[rawDict objectForKey:externalPrimaryKey]];
             
             if ( primaryValue != nil ) {
                 importedObject = [existingObjectsByID objectForKey:primaryValue];
@@ -96,6 +134,8 @@
             
             if ( importedObject != nil ) {
                 [updatedObjects setObject:importedObject forKey:primaryValue];
+                [session setObject:importedObject forPrimaryKeyValue:primaryValue entityName:entityName];
+                [identityMap registerObject:importedObject forPrimaryKeyValue:[importedObject valueForKey:primaryKey] entityName:entityName];
             }
         }];
         
@@ -106,15 +146,40 @@
         objects = [super rzi_objectsFromArray:array withMappings:mappings];
     }
 
+    session.importDepth -= 1;
+    [session.metrics endImportOfEntityNamed:plan.entityName];
+
     return objects;
 }
 
 - (void)rzi_importValuesFromDict:(NSDictionary *)dict withMappings:(NSDictionary *)mappings
 {
-    mappings = [[self class] rzi_primaryKeyMappingsDictWithMappings:mappings];
+    NSManagedObjectContext *context = self.managedObjectContext;
+    [context rzi_performImport:^{
+        RZVinylImportSession *session = [RZVinylImportSession currentSession];
+        BOOL hadChanges = self.hasChanges;
+
+        [self rzi_importValuesFromDict:dict withPlan:[[self class] rzi_importPlanWithMappings:mappings inContext:context]];
 
-    [self.managedObjectContext rzi_performImport:^{
-        [super rzi_importValuesFromDict:dict withMappings:mappings];
+        if ( !hadChanges && self.hasChanges &&
+             [session hasOptionsSet:RZVinylImportOptionsSkipUnchangedValues] && [self rzi_hasOnlyUnchangedValues] ) {
+            // Values that had to be converted before they could be compared were assigned anyway, but match what is stored
+            [self.managedObjectContext refreshObject:self mergeChanges:NO];
+        }
+        else if ( self.hasChanges ) {
+            [session addChangedObject:self];
+        }
+
+        if ( session.metrics != nil ) {
+            RZVinylImportRecordResult result = RZVinylImportRecordResultUnchanged;
+            if ( self.isInserted ) {
+                result = RZVinylImportRecordResultInserted;
+            }
+            else if ( self.hasChanges ) {
+                result = RZVinylImportRecordResultUpdated;
+            }
+            [session.metrics recordResult:result forEntityNamed:self.entity.name];
+        }
     }];
 }
 
@@ -135,10 +200,40 @@
     }
     
     id object = nil;
-    NSString *externalPrimaryKey = [self rzv_externalPrimaryKey] ?: [self rzv_primaryKey];
-    id primaryValue = externalPrimaryKey ? [dict objectForKey:externalPrimaryKey] : nil;
+    RZVinylImportPlan *plan = [self rzi_importPlanWithMappings:nil inContext:context];
+    id primaryValue = plan.externalPrimaryKey ? [plan normalizedPrimaryKeyValue:[dict objectForKey:plan.externalPrimaryKey]] : nil;
     if ( primaryValue != nil ) {
-        object = [self rzv_objectWithPrimaryKeyValue:primaryValue createNew:YES inContext:context];
+        RZVinylImportSession *session = [RZVinylImportSession currentSession];
+        NSString *entityName = [self rzv_entityName];
+        if ( [session hasPrefetchedEntityNamed:entityName] ) {
+            // The prefetch already resolved every existing object, so a miss means it must be created
+            object = [session objectForPrimaryKeyValue:primaryValue entityName:entityName];
+            if ( object == nil ) {
+                object = [self rzv_newObjectInContext:context];
+                [object setValue:primaryValue forKeyPath:[self rzv_primaryKey]];
+                [session setObject:object forPrimaryKeyValue:primaryValue entityName:entityName];
+                [[RZVinylIdentityMap identityMapForContext:context] registerObject:object forPrimaryKeyValue:primaryValue entityName:entityName];
+            }
+        }
+        else if ( [self rzi_canInsertWithoutFetchingWithPlan:plan inContext:context] ) {
+            RZVinylIdentityMap *identityMap = [RZVinylIdentityMap identityMapForContext:context];
+            object = [identityMap objectForPrimaryKeyValue:primaryValue entityName:entityName primaryKey:plan.primaryKey];
+            [session.metrics recordPrefetchQueries:0 identityMapHits:( object != nil ) ? 1 : 0 forEntityNamed:entityName];
+            if ( object == nil ) {
+                object = [self rzv_newObjectInContext:context];
+                [object setValue:primaryValue forKeyPath:plan.primaryKey];
+                [identityMap registerObject:object forPrimaryKeyValue:primaryValue entityName:entityName];
+            }
+        }
+        else if ( session.metrics != nil ) {
+            // Check the identity map here too, so the metrics can tell a hit from a fetch
+            object = [[RZVinylIdentityMap identityMapForContext:context] objectForPrimaryKeyValue:primaryValue entityName:entityName primaryKey:[self rzv_primaryKey]];
+            [session.metrics recordPrefetchQueries:( object == nil ) ? 1 : 0 identityMapHits:( object != nil ) ? 1 : 0 forEntityNamed:entityName];
+            object = object ?: [self rzv_objectWithPrimaryKeyValue:primaryValue createNew:YES inContext:context];
+        }
+        else {
+            object = [self rzv_objectWithPrimaryKeyValue:primaryValue createNew:YES inContext:context];
+        }
     }
     else {
         [self rzv_logUniqueObjectsWarning];
@@ -151,21 +246,17 @@
 - (BOOL)rzi_shouldImportValue:(id)value forKey:(NSString *)key {
 
     __block BOOL shouldImport = YES;
-    RZIPropertyInfo *propInfo = [[self class] rzi_propertyInfoForExternalKey:key withMappings:nil];
-    if ( propInfo != nil && (propInfo.dataType == RZImportDataTypeOtherObject || propInfo.dataType == RZImportDataTypeNSSet) ) {
+    NSManagedObjectContext *context = [NSManagedObjectContext rzi_currentThreadImportContext];
+    RZVinylImportPlanEntry *entry = [[[self class] rzi_importPlanWithMappings:nil inContext:context] entryForExternalKey:key];
 
-        // Check cached relationship mapping info. If collection type matches, perform automatic relationship import
-        __block RZVinylRelationshipInfo *relationshipInfo = nil;
-        
-        // !!!: This needs to be done in a thread-safe way - the cache is mutable state
-        rzv_performBlockAtomically(YES, ^{
-            relationshipInfo = [[self class] rzi_relationshipInfoForKey:key];
-        });
-        
-        if ( relationshipInfo != nil ) {
-            [self rzi_performRelationshipImportWithValue:value forRelationship:relationshipInfo];
-            shouldImport = NO;
-        }
+    // Check cached relationship mapping info. If collection type matches, perform automatic relationship import
+    if ( entry.relationshipInfo != nil ) {
+        [self rzi_performRelationshipImportWithValue:value forRelationship:entry.relationshipInfo];
+        shouldImport = NO;
+    }
+
+    if ( shouldImport && entry != nil && [[RZVinylImportSession currentSession] hasOptionsSet:RZVinylImportOptionsSkipUnchangedValues] ) {
+        shouldImport = ![self rzi_isUnchangedValue:value forAttributeNamed:entry.propertyName];
     }
     
     return shouldImport;
@@ -215,88 +306,658 @@
     return results;
 }
 
-#pragma mark - Private
++ (NSArray *)rzi_objectsFromArray:(NSArray *)array
+                        inContext:(NSManagedObjectContext *)context
+                     withMappings:(NSDictionary *)mappings
+                          options:(RZVinylImportOptions)options
+{
+    __block NSArray *results = nil;
+    [context rzi_performImport:^{
+        results = [self rzi_objectsFromArray:array withMappings:mappings];
+    } options:options];
+    return results;
+}
 
-+ (NSDictionary *)rzi_primaryKeyMappingsDictWithMappings:(NSDictionary *)mappings
+#pragma mark - Full Sync
+
++ (NSArray *)rzi_syncObjectsFromArray:(NSArray *)array
+                            inContext:(NSManagedObjectContext *)context
+                         withMappings:(NSDictionary *)mappings
+                              options:(RZVinylImportOptions)options
+                                scope:(NSPredicate *)scope
+                                error:(NSError *__autoreleasing *)error
 {
-    NSMutableDictionary *extraMappings = (mappings != nil) ? [mappings mutableCopy] : [NSMutableDictionary dictionary];
-    if ( [self rzi_primaryKeyMapping] ) {
-        [extraMappings addEntriesFromDictionary:[self rzi_primaryKeyMapping]];
+    if ( !RZVParameterAssert(array) || !RZVParameterAssert(context) ) {
+        return nil;
+    }
+
+    NSString *primaryKey = [self rzv_primaryKey];
+    if ( !RZVAssert(primaryKey != nil && ![self rzv_shouldAlwaysCreateNewObjectOnImport], @"Class %@ must provide a primary key to sync objects.", NSStringFromClass(self)) ) {
+        return nil;
     }
-    return [NSDictionary dictionaryWithDictionary:extraMappings];
+
+    __block NSArray *objects = nil;
+    __block BOOL success = NO;
+    __block NSError *syncErr = nil;
+    [context performBlockAndWait:^{
+        objects = [self rzi_objectsFromArray:array inContext:context withMappings:mappings options:options];
+
+        // Missing objects are only deleted from the store once the import itself has been saved.
+        // Child context saves don't assign permanent IDs, which the imported objects are matched by below.
+        NSArray *insertedObjects = [[context insertedObjects] allObjects];
+        if ( insertedObjects.count > 0 && ![context obtainPermanentIDsForObjects:insertedObjects error:&syncErr] ) {
+            return;
+        }
+        if ( ![context rzv_saveToStoreAndWait:&syncErr] ) {
+            return;
+        }
+
+        NSFetchRequest *fetch = [NSFetchRequest rzv_forEntityDescription:[self rzv_entityForContext:context] where:scope sort:nil];
+        fetch.resultType = NSManagedObjectIDResultType;
+        NSArray *scopedIDs = [context executeFetchRequest:fetch error:&syncErr];
+        if ( scopedIDs == nil ) {
+            return;
+        }
+
+        NSMutableSet *missingIDs = [NSMutableSet setWithArray:scopedIDs];
+        [missingIDs minusSet:[NSSet setWithArray:[objects valueForKey:@"objectID"]]];
+        if ( missingIDs.count > 0 && [self rzv_deleteObjectsWithIDs:[missingIDs allObjects] inContext:context error:&syncErr] == nil ) {
+            return;
+        }
+
+        // Objects that couldn't be deleted in the store were deleted from the context
+        success = [context rzv_saveToStoreAndWait:&syncErr];
+    }];
+
+    if ( !success ) {
+        RZVLogError(@"Error syncing objects of class %@: %@", NSStringFromClass(self), syncErr);
+        if ( error != NULL ) {
+            *error = syncErr;
+        }
+        return nil;
+    }
+
+    return objects;
 }
 
-+ (NSDictionary *)rzi_primaryKeyMapping
+#pragma mark - Large Imports
+
++ (BOOL)rzi_importObjectsFromArray:(NSArray *)array
+                         inContext:(NSManagedObjectContext *)context
+                      withMappings:(NSDictionary *)mappings
+                           options:(RZVinylImportOptions)options
+                         chunkSize:(NSUInteger)chunkSize
+                         objectIDs:(NSArray *__autoreleasing *)objectIDs
+                          progress:(RZVinylImportProgressBlock)progress
+                             error:(NSError *__autoreleasing *)error
 {
-    NSString *primaryKey = [self rzv_primaryKey];
-    NSString *externalPrimaryKey = [self rzv_externalPrimaryKey];
-    if ( primaryKey != nil && externalPrimaryKey != nil ) {
-        return @{ externalPrimaryKey : primaryKey };
+    if ( !RZVParameterAssert(array) || !RZVParameterAssert(context) || !RZVAssert(chunkSize > 0, @"Chunk size must be greater than zero") ) {
+        return NO;
     }
-    
-    // If no external primary key, then the external key is assumed to match
-    return nil;
+
+    NSMutableArray *importedIDs = ( objectIDs != NULL ) ? [NSMutableArray array] : nil;
+    NSError *importErr = nil;
+    BOOL stop = NO;
+
+    const NSUInteger totalCount = array.count;
+    for ( NSUInteger location = 0; location < totalCount && !stop; location += chunkSize ) {
+        @autoreleasepool {
+            NSArray *chunk = [array subarrayWithRange:NSMakeRange(location, MIN(chunkSize, totalCount - location))];
+            if ( ![self rzi_importAndSaveChunk:chunk inContext:context withMappings:mappings options:options objectIDs:importedIDs error:&importErr] ) {
+                break;
+            }
+            if ( progress ) {
+                progress(location + chunk.count, totalCount, &stop);
+            }
+        }
+    }
+
+    if ( objectIDs != NULL ) {
+        *objectIDs = [NSArray arrayWithArray:importedIDs];
+    }
+    if ( error != NULL && importErr != nil ) {
+        *error = importErr;
+    }
+
+    return ( importErr == nil );
 }
 
-+ (RZVinylRelationshipInfo *)rzi_relationshipInfoForKey:(NSString *)key
++ (void)rzi_importObjectsFromJSONStream:(NSInputStream *)stream
+                              inContext:(NSManagedObjectContext *)context
+                           withMappings:(NSDictionary *)mappings
+                                options:(RZVinylImportOptions)options
+                              batchSize:(NSUInteger)batchSize
+                               progress:(RZVinylImportProgressBlock)progress
+                             completion:(void (^)(NSUInteger, NSError *))completion
 {
-    static NSMutableDictionary *s_cachedRelationshipMappings = nil;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        s_cachedRelationshipMappings = [NSMutableDictionary dictionary];
+    if ( !RZVParameterAssert(stream) || !RZVParameterAssert(context) ||
+         !RZVAssert(batchSize > 0, @"Batch size must be greater than zero") ||
+         !RZVAssert(context.concurrencyType != NSConfinementConcurrencyType, @"Streaming imports require a queue-based context") ) {
+        return;
+    }
+
+    RZVinylJSONStreamReader *reader = [[RZVinylJSONStreamReader alloc] initWithInputStream:stream];
+    dispatch_semaphore_t pendingBatches = dispatch_semaphore_create(kRZVinylMaxPendingStreamBatches);
+
+    // Only accessed on the context's queue
+    __block NSUInteger importedCount = 0;
+    __block NSError *importErr = nil;
+    __block BOOL stop = NO;
+
+    // Set once the import stops or fails, and read by the reader between batches. Only accessed on finishedQueue,
+    // so the reader never waits behind the batches queued on the context.
+    __block BOOL finished = NO;
+    dispatch_queue_t finishedQueue = dispatch_queue_create("com.rzvinyl.streamImportFinishedQueue", DISPATCH_QUEUE_SERIAL);
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSError *readErr = nil;
+        while ( YES ) {
+            dispatch_semaphore_wait(pendingBatches, DISPATCH_TIME_FOREVER);
+            __block BOOL shouldFinish = NO;
+            dispatch_sync(finishedQueue, ^{
+                shouldFinish = finished;
+            });
+            if ( shouldFinish ) {
+                break;
+            }
+
+            NSArray *batch = nil;
+            @autoreleasepool {
+                batch = [reader nextElementsWithMaxCount:batchSize error:&readErr];
+            }
+            if ( batch.count == 0 ) {
+                break;
+            }
+
+            [context performBlock:^{
+                if ( !stop && importErr == nil ) {
+                    NSError *batchErr = nil;
+                    if ( [self rzi_importAndSaveChunk:batch inContext:context withMappings:mappings options:options objectIDs:nil error:&batchErr] ) {
+                        importedCount += batch.count;
+                        if ( progress ) {
+                            progress(importedCount, NSNotFound, &stop);
+                        }
+                    }
+                    else {
+                        importErr = batchErr;
+                    }
+
+                    if ( stop || importErr != nil ) {
+                        dispatch_sync(finishedQueue, ^{
+                            finished = YES;
+                        });
+                    }
+                }
+                dispatch_semaphore_signal(pendingBatches);
+            }];
+        }
+
+        // Every exit from the loop follows a wait, which must be balanced before the semaphore is released
+        dispatch_semaphore_signal(pendingBatches);
+        [reader close];
+
+        if ( readErr != nil ) {
+            RZVLogError(@"Error reading JSON stream for import: %@", readErr);
+        }
+
+        // Enqueued behind any outstanding batches
+        [context performBlock:^{
+            NSError *err = importErr ?: readErr;
+            if ( completion ) {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    completion(importedCount, err);
+                });
+            }
+        }];
     });
-    
-    NSString *className = NSStringFromClass(self);
-    NSMutableDictionary *classRelationshipMappings = [s_cachedRelationshipMappings objectForKey:className];
-    if ( classRelationshipMappings == nil ) {
-        classRelationshipMappings = [NSMutableDictionary dictionary];
-        [s_cachedRelationshipMappings setObject:classRelationshipMappings forKey:className];
+}
+
++ (void)rzi_importObjectsFromJSONFileURL:(NSURL *)fileURL
+                               inContext:(NSManagedObjectContext *)context
+                            withMappings:(NSDictionary *)mappings
+                                 options:(RZVinylImportOptions)options
+                               batchSize:(NSUInteger)batchSize
+                                progress:(RZVinylImportProgressBlock)progress
+                              completion:(void (^)(NSUInteger, NSError *))completion
+{
+    if ( !RZVParameterAssert(fileURL) ) {
+        return;
     }
-    
-    RZIPropertyInfo *propInfo = [self rzi_propertyInfoForExternalKey:key withMappings:nil];
-    
-    __block id relationshipInfo = [classRelationshipMappings objectForKey:key];
-    if ( relationshipInfo == nil && propInfo.propertyName != nil ) {
-        NSManagedObjectContext *context = [NSManagedObjectContext rzi_currentThreadImportContext];
-        NSManagedObjectModel *model = [[context persistentStoreCoordinator] managedObjectModel];
-        NSEntityDescription *entity = [[model entitiesByName] objectForKey:[self rzv_entityName]];
-        NSRelationshipDescription *relationshipDesc = [[entity relationshipsByName] objectForKey:propInfo.propertyName];
-        
-        if ( relationshipDesc != nil ) {
-            relationshipInfo = [RZVinylRelationshipInfo relationshipInfoFromDescription:relationshipDesc];
+
+    NSInputStream *stream = [NSInputStream inputStreamWithURL:fileURL];
+    if ( !RZVAssert(stream != nil, @"Unable to open a stream for file %@", fileURL) ) {
+        return;
+    }
+
+    [self rzi_importObjectsFromJSONStream:stream
+                                inContext:context
+                             withMappings:mappings
+                                  options:options
+                                batchSize:batchSize
+                                 progress:progress
+                               completion:completion];
+}
+
+#pragma mark - Parallel Imports
+
++ (void)rzi_importObjectsFromArray:(NSArray *)array
+                      withMappings:(NSDictionary *)mappings
+                           options:(RZVinylImportOptions)options
+                        shardCount:(NSUInteger)shardCount
+                        completion:(void (^)(NSError *))completion
+{
+    if ( !RZVParameterAssert(array) ) {
+        return;
+    }
+
+    RZCoreDataStack *stack = [self rzv_coreDataStack];
+    if ( !RZVAssert(stack != nil, @"No core data stack provided for class %@. Ensure that +rzv_coreDataStack is returning a valid instance.", NSStringFromClass(self)) ) {
+        return;
+    }
+
+    if ( shardCount == 0 ) {
+        shardCount = [[NSProcessInfo processInfo] activeProcessorCount];
+    }
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        // Shards are only partitioned by the receiver's primary key, so nested objects referenced from more than one
+        // shard are imported serially first. Every shard then finds them in the store instead of creating its own.
+        NSManagedObjectContext *nestedContext = [stack independentBackgroundManagedObjectContext];
+        NSError *nestedErr = nil;
+        BOOL nestedSuccess = [self rzi_importNestedObjectsFromArray:array inContext:nestedContext options:options error:&nestedErr];
+        [stack unregisterSaveNotificationsForContext:nestedContext];
+
+        if ( !nestedSuccess ) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if ( completion ) {
+                    completion(nestedErr);
+                }
+            });
+            return;
         }
-        
-        if ( relationshipInfo ) {
-            [classRelationshipMappings setObject:relationshipInfo forKey:key];
+
+        dispatch_group_t group = dispatch_group_create();
+        __block NSError *importErr = nil;
+
+        for ( NSArray *shard in [self rzi_shardsForArray:array count:shardCount] ) {
+            if ( shard.count == 0 ) {
+                continue;
+            }
+
+            dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                NSManagedObjectContext *context = [stack independentBackgroundManagedObjectContext];
+                if ( [context.mergePolicy mergeType] == NSErrorMergePolicyType ) {
+                    // Shards may update the same nested objects, so a conflicting save must not fail the shard
+                    context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
+                }
+
+                NSError *shardErr = nil;
+                if ( ![self rzi_importObjectsFromArray:shard
+                                             inContext:context
+                                          withMappings:mappings
+                                               options:options
+                                             chunkSize:kRZVinylParallelImportChunkSize
+                                             objectIDs:NULL
+                                              progress:nil
+                                                 error:&shardErr] ) {
+                    rzv_performBlockAtomically(YES, ^{
+                        if ( importErr == nil ) {
+                            importErr = shardErr;
+                        }
+                    });
+                }
+                [stack unregisterSaveNotificationsForContext:context];
+            });
+        }
+
+        dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+            if ( completion ) {
+                completion(importErr);
+            }
+        });
+    });
+}
+
+#pragma mark - Private
+
+/**
+ *  Partitions the array by a hash of each dictionary's primary key value.
+ *  Values are hashed by their description so that, for instance, @p @5 and @p @"5" land in the same shard.
+ */
++ (NSArray *)rzi_shardsForArray:(NSArray *)array count:(NSUInteger)count
+{
+    NSMutableArray *shards = [NSMutableArray arrayWithCapacity:count];
+    for ( NSUInteger i = 0; i < count; i++ ) {
+        [shards addObject:[NSMutableArray arrayWithCapacity:(array.count / count) + 1]];
+    }
+
+    NSString *externalPrimaryKey = [self rzv_shouldAlwaysCreateNewObjectOnImport] ? nil : ( [self rzv_externalPrimaryKey] ?: [self rzv_primaryKey] );
+
+    [array enumerateObjectsUsingBlock:^(NSDictionary *rawDict, NSUInteger idx, BOOL *stop) {
+        id primaryValue = externalPrimaryKey ? [rawDict objectForKey:externalPrimaryKey] : nil;
+        // Objects that can't be matched by primary key are always created, so they can go anywhere
+        NSUInteger hash = ( primaryValue != nil && primaryValue != [NSNull null] ) ? [[primaryValue description] hash] : idx;
+        [[shards objectAtIndex:hash % count] addObject:rawDict];
+    }];
+
+    return shards;
+}
+
+/**
+ *  Imports and saves every object nested in the relationships of the array's dictionaries that can be matched
+ *  by primary key, one entity at a time.
+ */
++ (BOOL)rzi_importNestedObjectsFromArray:(NSArray *)array
+                               inContext:(NSManagedObjectContext *)context
+                                 options:(RZVinylImportOptions)options
+                                   error:(NSError *__autoreleasing *)error
+{
+    NSMutableDictionary *nestedDictsByEntityName = [NSMutableDictionary dictionary];
+    NSMutableDictionary *classesByEntityName = [NSMutableDictionary dictionary];
+    [context rzi_performImport:^{
+        [self rzi_collectNestedDictionariesFromArray:array intoDictionary:nestedDictsByEntityName classes:classesByEntityName];
+    }];
+
+    for ( NSString *entityName in nestedDictsByEntityName ) {
+        Class moClass = [classesByEntityName objectForKey:entityName];
+        NSArray *nestedDicts = [[nestedDictsByEntityName objectForKey:entityName] allValues];
+        if ( ![moClass rzi_importObjectsFromArray:nestedDicts
+                                        inContext:context
+                                     withMappings:nil
+                                          options:options
+                                        chunkSize:kRZVinylParallelImportChunkSize
+                                        objectIDs:NULL
+                                         progress:nil
+                                            error:error] ) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/**
+ *  Collects the dictionaries nested in the relationships of the array's dictionaries, at any depth, keyed by entity
+ *  name and then by primary key value. Nested objects without a primary key value are always created, so they are skipped.
+ *  Must be called from inside an import.
+ */
++ (void)rzi_collectNestedDictionariesFromArray:(NSArray *)array
+                                intoDictionary:(NSMutableDictionary *)nestedDictsByEntityName
+                                       classes:(NSMutableDictionary *)classesByEntityName
+{
+    for ( NSDictionary *rawDict in array ) {
+        if ( ![rawDict isKindOfClass:[NSDictionary class]] ) {
+            continue;
+        }
+
+        [rawDict enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+            RZVinylRelationshipInfo *relationshipInfo = nil;
+            NSArray *nestedDicts = nil;
+
+            if ( [value isKindOfClass:[NSArray class]] ) {
+                relationshipInfo = [self rzi_relationshipInfoForKey:key];
+                nestedDicts = relationshipInfo.isToMany ? value : nil;
+            }
+            else if ( [value isKindOfClass:[NSDictionary class]] ) {
+                relationshipInfo = [self rzi_relationshipInfoForKey:key];
+                nestedDicts = ( relationshipInfo != nil && !relationshipInfo.isToMany ) ? @[value] : nil;
+            }
+
+            if ( nestedDicts != nil ) {
+                [relationshipInfo.destinationClass rzi_addNestedDictionaries:nestedDicts
+                                                               toDictionary:nestedDictsByEntityName
+                                                                    classes:classesByEntityName];
+            }
+        }];
+    }
+}
+
++ (void)rzi_addNestedDictionaries:(NSArray *)array
+                     toDictionary:(NSMutableDictionary *)nestedDictsByEntityName
+                          classes:(NSMutableDictionary *)classesByEntityName
+{
+    RZVinylImportPlan *plan = [self rzi_importPlanWithMappings:nil inContext:[NSManagedObjectContext rzi_currentThreadImportContext]];
+
+    if ( plan.entityName != nil && plan.externalPrimaryKey != nil && ![self rzv_shouldAlwaysCreateNewObjectOnImport] ) {
+        NSMutableDictionary *dictsByPrimaryValue = [nestedDictsByEntityName objectForKey:plan.entityName];
+        if ( dictsByPrimaryValue == nil ) {
+            dictsByPrimaryValue = [NSMutableDictionary dictionary];
+            [nestedDictsByEntityName setObject:dictsByPrimaryValue forKey:plan.entityName];
+            [classesByEntityName setObject:self forKey:plan.entityName];
+        }
+
+        for ( NSDictionary *rawDict in array ) {
+            if ( ![rawDict isKindOfClass:[NSDictionary class]] ) {
+                continue;
+            }
+            id primaryValue = [plan normalizedPrimaryKeyValue:[rawDict objectForKey:plan.externalPrimaryKey]];
+            if ( primaryValue != nil && [dictsByPrimaryValue objectForKey:primaryValue] == nil ) {
+                [dictsByPrimaryValue setObject:rawDict forKey:primaryValue];
+            }
+        }
+    }
+
+    [self rzi_collectNestedDictionariesFromArray:array intoDictionary:nestedDictsByEntityName classes:classesByEntityName];
+}
+
++ (BOOL)rzi_importAndSaveChunk:(NSArray *)chunk
+                     inContext:(NSManagedObjectContext *)context
+                  withMappings:(NSDictionary *)mappings
+                       options:(RZVinylImportOptions)options
+                     objectIDs:(NSMutableArray *)objectIDs
+                         error:(NSError *__autoreleasing *)error
+{
+    __block NSError *chunkErr = nil;
+    [context performBlockAndWait:^{
+        NSArray *objects = [self rzi_objectsFromArray:chunk inContext:context withMappings:mappings options:options];
+
+        // Child context saves don't assign permanent IDs, and temporary IDs are useless once the objects are faulted
+        NSArray *insertedObjects = [[context insertedObjects] allObjects];
+        if ( insertedObjects.count > 0 && ![context obtainPermanentIDsForObjects:insertedObjects error:&chunkErr] ) {
+            RZVLogError(@"Error obtaining permanent ID's for imported objects: %@", chunkErr);
+            return;
+        }
+
+        if ( ![context rzv_saveToStoreAndWait:&chunkErr] ) {
+            return;
+        }
+
+        [objectIDs addObjectsFromArray:[objects valueForKey:NSStringFromSelector(@selector(objectID))]];
+
+        // Release the row data of everything the chunk touched, including objects imported through relationships
+        for ( NSManagedObject *object in [[context registeredObjects] allObjects] ) {
+            if ( !object.hasChanges ) {
+                [context refreshObject:object mergeChanges:NO];
+            }
+        }
+    }];
+
+    if ( error != NULL && chunkErr != nil ) {
+        *error = chunkErr;
+    }
+    return ( chunkErr == nil );
+}
+
++ (RZVinylRelationshipInfo *)rzi_relationshipInfoForKey:(NSString *)key
+{
+    // !!!: Lock-free, plans are confined to the current thread and keep the relationship info of each key
+    NSManagedObjectContext *context = [NSManagedObjectContext rzi_currentThreadImportContext];
+    return [[self rzi_importPlanWithMappings:nil inContext:context] entryForExternalKey:key].relationshipInfo;
+}
+
++ (RZVinylImportPlan *)rzi_importPlanWithMappings:(NSDictionary *)mappings inContext:(NSManagedObjectContext *)context
+{
+    return [RZVinylImportPlan planForClass:self mappings:mappings model:context.persistentStoreCoordinator.managedObjectModel];
+}
+
+/**
+ *  Assigns the values of keys resolved by the plan directly, handing any other keys (and values that need
+ *  converting to the attribute's type) to RZImport.
+ */
+- (void)rzi_importValuesFromDict:(NSDictionary *)dict withPlan:(RZVinylImportPlan *)plan
+{
+    NSMutableDictionary *unplannedValues = nil;
+
+    for ( NSString *key in dict ) {
+        id value = [dict objectForKey:key];
+        RZVinylImportPlanEntry *entry = [plan entryForExternalKey:key];
+
+        BOOL assignable = ( entry.relationshipInfo != nil || value == [NSNull null] || ( entry.attributeClass != Nil && [value isKindOfClass:entry.attributeClass] ) );
+        if ( entry == nil || !assignable ) {
+            if ( unplannedValues == nil ) {
+                unplannedValues = [NSMutableDictionary dictionary];
+            }
+            [unplannedValues setObject:value forKey:key];
+            continue;
+        }
+
+        if ( ![self rzi_shouldImportValue:value forKey:key] ) {
+            continue;
+        }
+
+        if ( value == [NSNull null] ) {
+            [self rzi_setNilForPropertyNamed:entry.propertyName];
+        }
+        else if ( entry.relationshipInfo != nil ) {
+            // A subclass chose not to import the relationship automatically, so let RZImport try
+            [super rzi_importValuesFromDict:@{ key : value } withMappings:plan.mappings];
         }
         else {
-            [classRelationshipMappings setObject:[NSNull null] forKey:key];
+            [self setValue:value forKey:entry.propertyName];
+        }
+    }
+
+    if ( unplannedValues != nil ) {
+        [super rzi_importValuesFromDict:unplannedValues withMappings:plan.mappings];
+    }
+}
+
++ (void)rzi_prefetchObjectGraphForArray:(NSArray *)array inContext:(NSManagedObjectContext *)context
+{
+    NSMutableDictionary *primaryValuesByEntityName = [NSMutableDictionary dictionary];
+    NSMutableDictionary *classesByEntityName = [NSMutableDictionary dictionary];
+    [self rzi_collectPrimaryValuesFromArray:array intoDictionary:primaryValuesByEntityName classes:classesByEntityName];
+
+    // One fetch per entity, regardless of how many parent objects reference it
+    RZVinylImportSession *session = [RZVinylImportSession currentSession];
+    [primaryValuesByEntityName enumerateKeysAndObjectsUsingBlock:^(NSString *entityName, NSSet *primaryValues, BOOL *stop) {
+        Class moClass = [classesByEntityName objectForKey:entityName];
+        NSDictionary *existingObjsByID = [moClass rzi_existingObjectsByPrimaryKeyValue:primaryValues inContext:context];
+        [session addPrefetchedObjects:existingObjsByID forEntityName:entityName];
+    }];
+}
+
++ (void)rzi_collectPrimaryValuesFromArray:(NSArray *)array
+                           intoDictionary:(NSMutableDictionary *)primaryValuesByEntityName
+                                  classes:(NSMutableDictionary *)classesByEntityName
+{
+    RZVinylImportPlan *plan = [self rzi_importPlanWithMappings:nil inContext:[NSManagedObjectContext rzi_currentThreadImportContext]];
+    NSString *entityName = plan.entityName;
+    NSString *primaryKey = plan.primaryKey;
+    NSString *externalPrimaryKey = plan.externalPrimaryKey;
+
+    NSMutableSet *primaryValues = nil;
+    if ( entityName != nil && primaryKey != nil && ![self rzv_shouldAlwaysCreateNewObjectOnImport] ) {
+        primaryValues = [primaryValuesByEntityName objectForKey:entityName];
+        if ( primaryValues == nil ) {
+            primaryValues = [NSMutableSet set];
+            [primaryValuesByEntityName setObject:primaryValues forKey:entityName];
+            [classesByEntityName setObject:self forKey:entityName];
         }
     }
 
-    // !!!: To prevent further checking of non-relationship keys, we cache NSNull
-    //      so this ensures that a valid relationshipInfo object is returned
-    return [relationshipInfo isEqual:[NSNull null]] ? nil : relationshipInfo;
+    for ( NSDictionary *rawDict in array ) {
+        if ( ![rawDict isKindOfClass:[NSDictionary class]] ) {
+            continue;
+        }
+
+        id primaryValue = externalPrimaryKey ? [plan normalizedPrimaryKeyValue:[rawDict objectForKey:externalPrimaryKey]] : nil;
+        if ( primaryValue != nil ) {
+            [primaryValues addObject:primaryValue];
+        }
+
+        [rawDict enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+            // Only collection values can represent nested objects
+            if ( ![value isKindOfClass:[NSArray class]] && ![value isKindOfClass:[NSDictionary class]] ) {
+                return;
+            }
+
+            RZVinylRelationshipInfo *relationshipInfo = [self rzi_relationshipInfoForKey:key];
+
+            if ( relationshipInfo.isToMany && [value isKindOfClass:[NSArray class]] ) {
+                [relationshipInfo.destinationClass rzi_collectPrimaryValuesFromArray:value
+                                                                      intoDictionary:primaryValuesByEntityName
+                                                                             classes:classesByEntityName];
+            }
+            else if ( relationshipInfo != nil && !relationshipInfo.isToMany && [value isKindOfClass:[NSDictionary class]] ) {
+                [relationshipInfo.destinationClass rzi_collectPrimaryValuesFromArray:@[value]
+                                                                      intoDictionary:primaryValuesByEntityName
+                                                                             classes:classesByEntityName];
+            }
+        }];
+    }
 }
 
 + (NSDictionary *)rzi_existingObjectsByIDForArray:(NSArray *)array inContext:(NSManagedObjectContext *)context
 {
-    NSString *primaryKey = [self rzv_primaryKey];
-    NSString *externalPrimaryKey = [self rzv_externalPrimaryKey] ?: primaryKey;
-    
-    NSSet       *primaryKeySet   = [NSSet setWithArray:[array valueForKey:externalPrimaryKey]];
-    NSPredicate *existingObjPred = [NSPredicate predicateWithFormat:@"%K in %@", primaryKey, primaryKeySet];
-    NSArray     *existingObjects = [self rzv_where:existingObjPred inContext:context];
-    
-    NSMutableDictionary *existingObjsByID = [NSMutableDictionary dictionary];
-    [existingObjects enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
-        id primaryValue = [obj valueForKey:primaryKey];
-        if ( primaryValue ) {
-            [existingObjsByID setObject:obj forKey:primaryValue];
+    RZVinylImportSession *session = [RZVinylImportSession currentSession];
+    NSString *entityName = [self rzv_entityName];
+    if ( [session hasPrefetchedEntityNamed:entityName] ) {
+        return [session objectsByPrimaryKeyValueForEntityNamed:entityName];
+    }
+
+    RZVinylImportPlan *plan = [self rzi_importPlanWithMappings:nil inContext:context];
+    NSMutableSet *primaryKeySet = [NSMutableSet setWithCapacity:array.count];
+    for ( NSDictionary *rawDict in array ) {
+        id primaryValue = [plan normalizedPrimaryKeyValue:[rawDict objectForKey:plan.externalPrimaryKey]];
+        if ( primaryValue != nil ) {
+            [primaryKeySet addObject:primaryValue];
         }
-    }];
-    
-    return [NSDictionary dictionaryWithDictionary:existingObjsByID];
+    }
+    return [self rzi_existingObjectsByPrimaryKeyValue:primaryKeySet inContext:context];
+}
+
++ (NSDictionary *)rzi_existingObjectsByPrimaryKeyValue:(NSSet *)primaryValues inContext:(NSManagedObjectContext *)context
+{
+    RZVinylImportSession *session = [RZVinylImportSession currentSession];
+    RZVinylImportPlan *plan = [self rzi_importPlanWithMappings:nil inContext:context];
+    NSUInteger fetchCount = 0;
+    NSUInteger identityMapHitCount = 0;
+    NSDictionary *existingObjsByID = nil;
+
+    if ( [self rzi_canInsertWithoutFetchingWithPlan:plan inContext:context] ) {
+        // The store matches everything else when the context is saved
+        RZVinylIdentityMap *identityMap = [RZVinylIdentityMap identityMapForContext:context];
+        NSMutableDictionary *registeredObjsByID = [NSMutableDictionary dictionary];
+        for ( id primaryValue in primaryValues ) {
+            NSManagedObject *object = [identityMap objectForPrimaryKeyValue:primaryValue entityName:plan.entityName primaryKey:plan.primaryKey];
+            if ( object != nil ) {
+                [registeredObjsByID setObject:object forKey:primaryValue];
+            }
+        }
+        existingObjsByID = registeredObjsByID;
+        identityMapHitCount = registeredObjsByID.count;
+    }
+    else {
+        existingObjsByID = [self rzv_existingObjectsByPrimaryKeyValue:primaryValues
+                                                            inContext:context
+                                                             keysOnly:[session hasOptionsSet:RZVinylImportOptionsFetchKeysOnly]
+                                                           fetchCount:&fetchCount
+                                                  identityMapHitCount:&identityMapHitCount];
+    }
+
+    [session.metrics recordPrefetchQueries:fetchCount identityMapHits:identityMapHitCount forEntityNamed:plan.entityName];
+    return existingObjsByID;
+}
+
+/**
+ *  Whether existing objects can be left for the store to find, because the import asked for it, the entity
+ *  has a uniqueness constraint on its primary key, and the context resolves the conflicts in favor of the import.
+ */
++ (BOOL)rzi_canInsertWithoutFetchingWithPlan:(RZVinylImportPlan *)plan inContext:(NSManagedObjectContext *)context
+{
+    return ( [[RZVinylImportSession currentSession] hasOptionsSet:RZVinylImportOptionsUpsertUsingUniquenessConstraints] &&
+             plan.hasPrimaryKeyUniquenessConstraint &&
+             [context.mergePolicy mergeType] == NSMergeByPropertyObjectTrumpMergePolicyType );
 }
 
 - (void)rzi_performRelationshipImportWithValue:(id)value forRelationship:(RZVinylRelationshipInfo *)relationshipInfo
@@ -309,9 +970,11 @@
     if ( !RZVAssert(context != nil, @"There should be a current thread import context.") ) {
         return;
     }
+
+    [[RZVinylImportSession currentSession].metrics recordRelationshipImportForEntityNamed:relationshipInfo.sourceEntityName];
     
     if ( value == nil ) {
-        [self rzi_setNilForPropertyNamed:relationshipInfo.sourcePropertyName];
+        [self rzi_setValue:nil forRelationshipNamed:relationshipInfo.sourcePropertyName];
     }
     else if ( relationshipInfo.isToMany ) {
         
@@ -327,10 +990,10 @@
         NSArray *importedObjects = [relationshipInfo.destinationClass rzi_objectsFromArray:rawObjects];
         if ( importedObjects != nil ) {
             if ( relationshipInfo.isOrdered ) {
-                [self setValue:[[NSOrderedSet alloc] initWithArray:importedObjects] forKey:relationshipInfo.sourcePropertyName];
+                [self rzi_setValue:[[NSOrderedSet alloc] initWithArray:importedObjects] forRelationshipNamed:relationshipInfo.sourcePropertyName];
             }
             else {
-                [self setValue:[NSSet setWithArray:importedObjects] forKey:relationshipInfo.sourcePropertyName];
+                [self rzi_setValue:[NSSet setWithArray:importedObjects] forRelationshipNamed:relationshipInfo.sourcePropertyName];
             }
 
         }
@@ -353,7 +1016,7 @@
         
         id importedObject = [relationshipInfo.destinationClass rzi_objectFromDictionary:value];
         if ( importedObject != nil ) {
-            [self setValue:importedObject forKey:relationshipInfo.sourcePropertyName];
+            [self rzi_setValue:importedObject forRelationshipNamed:relationshipInfo.sourcePropertyName];
         }
         else {
             RZVLogError(@"Unable to import object for relationship \"%@\" on entity \"%@\" from value:\n%@",
@@ -364,6 +1027,58 @@
     }
 }
 
+- (void)rzi_setValue:(id)value forRelationshipNamed:(NSString *)relationshipName
+{
+    RZVinylImportSession *session = [RZVinylImportSession currentSession];
+    if ( [session hasOptionsSet:RZVinylImportOptionsSkipUnchangedValues] ) {
+        if ( RZVImportValuesAreEqual([self valueForKey:relationshipName], value) ) {
+            return;
+        }
+    }
+
+    if ( value == nil ) {
+        [self rzi_setNilForPropertyNamed:relationshipName];
+    }
+    else {
+        [self setValue:value forKey:relationshipName];
+    }
+}
+
+/**
+ *  Whether the incoming value can be compared to the current value of an attribute as-is.
+ *  Values that RZImport has to convert first (for instance, date strings) are assigned and compared after the import.
+ */
+- (BOOL)rzi_isUnchangedValue:(id)value forAttributeNamed:(NSString *)attributeName
+{
+    NSAttributeDescription *attribute = [[self.entity attributesByName] objectForKey:attributeName];
+    if ( attribute == nil ) {
+        return NO;
+    }
+
+    id currentValue = [self valueForKey:attributeName];
+    if ( value == nil || value == [NSNull null] ) {
+        return ( currentValue == nil );
+    }
+
+    Class attributeClass = NSClassFromString(attribute.attributeValueClassName);
+    return ( attributeClass != Nil && [value isKindOfClass:attributeClass] && [value isEqual:currentValue] );
+}
+
+/**
+ *  Whether every value changed since the object was last fetched or saved is equal to its committed value.
+ */
+- (BOOL)rzi_hasOnlyUnchangedValues
+{
+    NSDictionary *changedValues = [self changedValues];
+    NSDictionary *committedValues = [self committedValuesForKeys:[changedValues allKeys]];
+    for ( NSString *key in changedValues ) {
+        if ( !RZVImportValuesAreEqual([changedValues objectForKey:key], [committedValues objectForKey:key]) ) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
 + (void)rzv_logUniqueObjectsWarning
 {
     rzv_performBlockAtomically(NO, ^{
@@ -27,6 +27,52 @@
 //  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 @import CoreData;
+#import "RZVinylImportMetrics.h"
+
+typedef NS_OPTIONS(NSUInteger, RZVinylImportOptions)
+{
+    /**
+     *  Pass this option to walk the entire payload before any values are assigned, collecting the primary
+     *  key values of every object to be imported (including objects nested in relationships) for each entity.
+     *  Existing objects are then resolved with a single fetch per entity, rather than one fetch per parent object.
+     */
+    RZVinylImportOptionsPrefetchRelationships = (1 << 0),
+
+    /**
+     *  Pass this option to compare each incoming value with the object's current value, and only assign it when
+     *  it differs. This includes the objects of relationships. Objects whose values are all unchanged are not
+     *  marked as updated, so they are not written to the store or merged into other contexts when saved.
+     *
+     *  @note Comparing to-many relationships fires their faults for existing objects.
+     */
+    RZVinylImportOptionsSkipUnchangedValues = (1 << 1),
+
+    /**
+     *  Pass this option to look up existing objects by fetching only their primary key and object ID, rather than
+     *  fully populated objects. Objects that aren't already registered in the context are returned as faults, and
+     *  their values are only loaded when the import assigns to them.
+     *
+     *  @note This reduces memory use and row cache churn for large payloads that match many existing objects,
+     *        at the cost of one store read per existing object that is updated. If a parent context has
+     *        unsaved changes, the objects are fetched normally.
+     */
+    RZVinylImportOptionsFetchKeysOnly = (1 << 2),
+
+    /**
+     *  Pass this option to insert objects without fetching existing objects first, for entities that have a
+     *  uniqueness constraint on their primary key. The store finds the existing objects when the context is saved,
+     *  and merges the imported values into them. Objects already registered in the context are still reused.
+     *
+     *  @note The importing context and the contexts it saves through must use the
+     *        @p NSMergeByPropertyObjectTrumpMergePolicy, otherwise the save fails with a constraint conflict.
+     *        @see @p RZCoreDataStackOptionsMergeByPropertyObjectTrump. If the importing context has another merge
+     *        policy, or the entity has no constraint on its primary key, objects are fetched as usual.
+     *
+     *  @warning An imported object may be merged into an existing object when the context is saved. Look objects
+     *           up by primary key after saving rather than holding on to the imported objects.
+     */
+    RZVinylImportOptionsUpsertUsingUniquenessConstraints = (1 << 3)
+};
 
 @interface NSManagedObjectContext (RZImport)
 
@@ -37,6 +83,32 @@
  */
 - (void)rzi_performImport:(void(^)(void))importBlock;
 
+/**
+ *  Specify that this managed object context should be used for all subsequent
+ *  RZImport operations, using the provided import options.
+ *
+ *  @param importBlock The block performing the import.
+ *  @param options     Options for all of the imports performed in the block.
+ *
+ *  @note If this context is already importing on the current thread, the options
+ *        of the outermost import are used.
+ *
+ *  @return The number of objects inserted or changed by the imports performed in the block. Without
+ *          @p RZVinylImportOptionsSkipUnchangedValues, objects that were assigned values equal to their current
+ *          values are counted too. Objects that already had unsaved changes are always counted. When this context
+ *          is already importing on the current thread, the objects are counted by the outermost import and zero is returned.
+ */
+- (NSUInteger)rzi_performImport:(void(^)(void))importBlock options:(RZVinylImportOptions)options;
+
+/**
+ *  An optional collector of metrics for every import into this context. When set, a report is produced
+ *  at the end of each outermost call to @p -rzi_performImport:.
+ *
+ *  @note The metrics object is only accessed on this context's queue.
+ */
+- (RZVinylImportMetrics *)rzi_importMetrics;
+- (void)rzi_setImportMetrics:(RZVinylImportMetrics *)importMetrics;
+
 /**
  *  The managed object context that is being imported to. This is set internally
  *  and by the `rzi_performImport:` method.
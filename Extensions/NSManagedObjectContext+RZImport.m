@@ -28,6 +28,10 @@
 
 #import "NSManagedObjectContext+RZImport.h"
 #import "RZCoreDataStack.h"
+#import "RZVinylImportSession.h"
+#import "RZVinylImportMetrics_private.h"
+
+static NSString * const kRZVinylImportMetricsKey = @"RZVinylImportMetrics";
 
 @implementation NSThread (RZImport)
 
@@ -54,18 +58,50 @@ static NSString * const kRZVinylImportThreadContextKey = @"RZVinylImportThreadCo
 @implementation NSManagedObjectContext (RZImport)
 
 - (void)rzi_performImport:(void(^)(void))importBlock
+{
+    [self rzi_performImport:importBlock options:kNilOptions];
+}
+
+- (NSUInteger)rzi_performImport:(void(^)(void))importBlock options:(RZVinylImportOptions)options
 {
     NSParameterAssert(importBlock);
+    NSUInteger changedObjectCount = 0;
     NSThread *thread = [NSThread currentThread];
     NSManagedObjectContext *initialImportContext = [thread rzi_currentImportContext];
     if (initialImportContext != self) {
+        RZVinylImportSession *initialSession = [RZVinylImportSession currentSession];
+        RZVinylImportSession *session = [[RZVinylImportSession alloc] initWithOptions:options];
         [thread rzi_setCurrentImportContext:self];
-        [self performBlockAndWait:importBlock];
+        [RZVinylImportSession setCurrentSession:session];
+        [self performBlockAndWait:^{
+            session.metrics = [self rzi_importMetrics];
+            [session.metrics beginImport];
+            importBlock();
+            [session.metrics finishImport];
+        }];
+        [RZVinylImportSession setCurrentSession:initialSession];
         [thread rzi_setCurrentImportContext:initialImportContext];
+        changedObjectCount = session.changedObjectCount;
     }
     else {
         importBlock();
     }
+    return changedObjectCount;
+}
+
+- (RZVinylImportMetrics *)rzi_importMetrics
+{
+    return [[self userInfo] objectForKey:kRZVinylImportMetricsKey];
+}
+
+- (void)rzi_setImportMetrics:(RZVinylImportMetrics *)importMetrics
+{
+    if ( importMetrics ) {
+        [[self userInfo] setObject:importMetrics forKey:kRZVinylImportMetricsKey];
+    }
+    else {
+        [[self userInfo] removeObjectForKey:kRZVinylImportMetricsKey];
+    }
 }
 
 + (NSManagedObjectContext *)rzi_currentThreadImportContext
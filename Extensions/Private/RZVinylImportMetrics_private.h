@@ -0,0 +1,57 @@
+//
+//  RZVinylImportMetrics_private.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylImportMetrics.h"
+
+typedef NS_ENUM(NSUInteger, RZVinylImportRecordResult) {
+    RZVinylImportRecordResultInserted,
+    RZVinylImportRecordResultUpdated,
+    RZVinylImportRecordResultUnchanged
+};
+
+/**
+ *  Recording methods for RZVinylImportMetrics.
+ *  FOR INTERNAL LIBRARY USE ONLY
+ */
+@interface RZVinylImportMetrics ()
+
+- (void)beginImport;
+- (RZVinylImportReport *)finishImport;
+
+/**
+ *  Begin and end timing the import of an entity. Calls may be nested, in which case the time spent
+ *  in the inner import is only counted towards the inner entity.
+ */
+- (void)beginImportOfEntityNamed:(NSString *)entityName;
+- (void)endImportOfEntityNamed:(NSString *)entityName;
+
+- (void)recordPrefetchQueries:(NSUInteger)queryCount identityMapHits:(NSUInteger)hitCount forEntityNamed:(NSString *)entityName;
+- (void)recordResult:(RZVinylImportRecordResult)result forEntityNamed:(NSString *)entityName;
+- (void)recordRelationshipImportForEntityNamed:(NSString *)entityName;
+
+@end
@@ -0,0 +1,104 @@
+//
+//  RZVinylImportPlan.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@import CoreData;
+
+@class RZVinylRelationshipInfo;
+
+/**
+ *  How a single external key of an import dictionary is assigned.
+ *  FOR INTERNAL LIBRARY USE ONLY
+ */
+@interface RZVinylImportPlanEntry : NSObject
+
+@property (nonatomic, readonly, copy)   NSString *propertyName;
+
+/**
+ *  The relationship the key maps to, or nil if it maps to an attribute.
+ */
+@property (nonatomic, readonly, strong) RZVinylRelationshipInfo *relationshipInfo;
+
+/**
+ *  The class of the attribute's values. Values of this class can be assigned without conversion.
+ */
+@property (nonatomic, readonly, assign) Class attributeClass;
+
+@end
+
+/**
+ *  The resolved import metadata for a managed object class and set of extra mappings:
+ *  the merged mappings, primary key names, and a table of external key to property.
+ *  Plans are cached per thread and per model, so they are never shared and never locked. Each thread's cache is
+ *  bounded, and a model's plans are dropped once the model is deallocated.
+ *  FOR INTERNAL LIBRARY USE ONLY
+ */
+@interface RZVinylImportPlan : NSObject
+
+/**
+ *  The plan for importing into the class with the provided mappings, from the current thread's cache.
+ *
+ *  @param moClass  The managed object class being imported.
+ *  @param mappings Extra mappings passed to the import, or the @p mappings of another plan for the class.
+ *  @param model    The model of the import context, used to resolve the entity and its relationships.
+ */
++ (RZVinylImportPlan *)planForClass:(Class)moClass mappings:(NSDictionary *)mappings model:(NSManagedObjectModel *)model;
+
+/**
+ *  Drop every plan in the current thread's cache, so the next import on the thread compiles its plans again.
+ */
++ (void)removeCachedPlansForCurrentThread;
+
+@property (nonatomic, readonly, assign) Class moClass;
+
+/**
+ *  The extra mappings merged with the class's primary key mapping.
+ */
+@property (nonatomic, readonly, copy) NSDictionary *mappings;
+
+@property (nonatomic, readonly, copy) NSString *entityName;
+@property (nonatomic, readonly, copy) NSString *primaryKey;
+@property (nonatomic, readonly, copy) NSString *externalPrimaryKey;
+
+/**
+ *  Whether the entity has a uniqueness constraint on the primary key alone.
+ */
+@property (nonatomic, readonly, assign) BOOL hasPrimaryKeyUniquenessConstraint;
+
+/**
+ *  A primary key value from an import dictionary, converted to the type of the primary key attribute.
+ *  Every lookup of existing objects uses this form, so that keys match regardless of how they were sent.
+ */
+- (id)normalizedPrimaryKeyValue:(id)primaryValue;
+
+/**
+ *  The entry for an external key, resolved on first use. Returns nil for keys that RZImport must handle
+ *  itself, such as unknown keys and the keys returned by @p +rzi_ignoredKeys or @p +rzi_nestedObjectKeys.
+ */
+- (RZVinylImportPlanEntry *)entryForExternalKey:(NSString *)key;
+
+@end
@@ -0,0 +1,228 @@
+//
+//  RZVinylImportPlan.m
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylImportPlan.h"
+#import "RZVinylRelationshipInfo.h"
+#import "NSObject+RZImport_private.h"
+#import "NSManagedObject+RZImport.h"
+#import "NSManagedObject+RZImportableSubclass.h"
+#import "NSManagedObject+RZVinylRecord.h"
+#import "NSManagedObject+RZVinylUtils.h"
+#import "NSManagedObject+RZVinylRecord_private.h"
+
+static NSString * const kRZVinylImportPlanThreadCacheKey = @"RZVinylImportPlanCache";
+
+// Bounds on each thread's cache. Models are rarely replaced, but each call with new extra mappings adds a plan.
+static const NSUInteger kRZVinylImportPlanMaxCachedModels = 4;
+static const NSUInteger kRZVinylImportPlanMaxCachedPlansPerClass = 64;
+
+@interface RZVinylImportPlanEntry ()
+
+@property (nonatomic, readwrite, copy)   NSString *propertyName;
+@property (nonatomic, readwrite, strong) RZVinylRelationshipInfo *relationshipInfo;
+@property (nonatomic, readwrite, assign) Class attributeClass;
+
+@end
+
+@implementation RZVinylImportPlanEntry
+
+@end
+
+@interface RZVinylImportPlan ()
+
+@property (nonatomic, readwrite, assign) Class moClass;
+@property (nonatomic, readwrite, copy) NSDictionary *mappings;
+@property (nonatomic, readwrite, copy) NSString *entityName;
+@property (nonatomic, readwrite, copy) NSString *primaryKey;
+@property (nonatomic, readwrite, copy) NSString *externalPrimaryKey;
+@property (nonatomic, readwrite, assign) BOOL hasPrimaryKeyUniquenessConstraint;
+
+// Weak, so that cached plans don't keep the model of a torn down stack alive
+@property (nonatomic, weak) NSManagedObjectModel *model;
+@property (nonatomic, strong) NSDictionary *attributesByName;
+@property (nonatomic, strong) NSAttributeDescription *primaryKeyAttribute;
+@property (nonatomic, strong) NSSet *unplannedExternalKeys;
+@property (nonatomic, strong) NSMutableDictionary *entriesByExternalKey;
+
+@end
+
+@implementation RZVinylImportPlan
+
++ (RZVinylImportPlan *)planForClass:(Class)moClass mappings:(NSDictionary *)mappings model:(NSManagedObjectModel *)model
+{
+    // model -> (class name -> (mappings -> plan)). Models are weak keys, so a model's plans are dropped when its
+    // stack is torn down. Each plan is registered under both the mappings it was created with and its merged
+    // mappings, so passing a plan's mappings back in finds the same plan.
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    NSMapTable *threadCache = [threadDictionary objectForKey:kRZVinylImportPlanThreadCacheKey];
+    if ( threadCache == nil ) {
+        threadCache = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                valueOptions:NSPointerFunctionsStrongMemory
+                                                    capacity:0];
+        [threadDictionary setObject:threadCache forKey:kRZVinylImportPlanThreadCacheKey];
+    }
+
+    id modelKey = model ?: [NSNull null];
+    NSMutableDictionary *modelCache = [threadCache objectForKey:modelKey];
+    if ( modelCache == nil ) {
+        if ( threadCache.count >= kRZVinylImportPlanMaxCachedModels ) {
+            [threadCache removeAllObjects];
+        }
+        modelCache = [NSMutableDictionary dictionary];
+        [threadCache setObject:modelCache forKey:modelKey];
+    }
+
+    NSString *className = NSStringFromClass(moClass);
+    NSMutableDictionary *plansByMappings = [modelCache objectForKey:className];
+    if ( plansByMappings == nil ) {
+        plansByMappings = [NSMutableDictionary dictionary];
+        [modelCache setObject:plansByMappings forKey:className];
+    }
+
+    id mappingsKey = mappings ?: [NSNull null];
+    RZVinylImportPlan *plan = [plansByMappings objectForKey:mappingsKey];
+    if ( plan == nil ) {
+        if ( plansByMappings.count >= kRZVinylImportPlanMaxCachedPlansPerClass ) {
+            [plansByMappings removeAllObjects];
+        }
+        plan = [[self alloc] initWithClass:moClass mappings:mappings model:model];
+        [plansByMappings setObject:plan forKey:mappingsKey];
+        [plansByMappings setObject:plan forKey:plan.mappings];
+    }
+    return plan;
+}
+
++ (void)removeCachedPlansForCurrentThread
+{
+    [[[NSThread currentThread] threadDictionary] removeObjectForKey:kRZVinylImportPlanThreadCacheKey];
+}
+
+- (instancetype)initWithClass:(Class)moClass mappings:(NSDictionary *)mappings model:(NSManagedObjectModel *)model
+{
+    self = [super init];
+    if ( self ) {
+        _moClass = moClass;
+        _model = model;
+        _primaryKey = [[moClass rzv_primaryKey] copy];
+        _externalPrimaryKey = [([moClass rzv_externalPrimaryKey] ?: _primaryKey) copy];
+
+        NSMutableDictionary *mergedMappings = ( mappings != nil ) ? [mappings mutableCopy] : [NSMutableDictionary dictionary];
+        if ( _primaryKey != nil && [moClass rzv_externalPrimaryKey] != nil ) {
+            [mergedMappings setObject:_primaryKey forKey:_externalPrimaryKey];
+        }
+        _mappings = [mergedMappings copy];
+
+        NSEntityDescription *entity = [moClass rzv_entity];
+        if ( model != nil && entity.managedObjectModel != model ) {
+            entity = [[model entitiesByName] objectForKey:[moClass rzv_entityName]];
+        }
+        _entityName = [entity.name copy];
+        _attributesByName = entity.attributesByName;
+        _primaryKeyAttribute = ( _primaryKey != nil ) ? [_attributesByName objectForKey:_primaryKey] : nil;
+        _hasPrimaryKeyUniquenessConstraint = [self entityHasUniquenessConstraintOnPrimaryKey:entity];
+
+        // RZImport skips ignored keys and imports nested object keys into the receiver, so neither can be assigned directly
+        NSMutableSet *unplannedKeys = [NSMutableSet set];
+        if ( [moClass respondsToSelector:@selector(rzi_ignoredKeys)] ) {
+            [unplannedKeys addObjectsFromArray:[moClass rzi_ignoredKeys]];
+        }
+        if ( [moClass respondsToSelector:@selector(rzi_nestedObjectKeys)] ) {
+            [unplannedKeys addObjectsFromArray:[moClass rzi_nestedObjectKeys]];
+        }
+        _unplannedExternalKeys = [unplannedKeys copy];
+        _entriesByExternalKey = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (RZVinylImportPlanEntry *)entryForExternalKey:(NSString *)key
+{
+    id entry = [self.entriesByExternalKey objectForKey:key];
+    if ( entry == nil ) {
+        entry = [self resolveEntryForExternalKey:key] ?: [NSNull null];
+        [self.entriesByExternalKey setObject:entry forKey:key];
+    }
+    return ( entry == [NSNull null] ) ? nil : entry;
+}
+
+- (id)normalizedPrimaryKeyValue:(id)primaryValue
+{
+    return [self.moClass rzv_normalizedPrimaryKeyValue:primaryValue forAttribute:self.primaryKeyAttribute];
+}
+
+#pragma mark - Private
+
+- (BOOL)entityHasUniquenessConstraintOnPrimaryKey:(NSEntityDescription *)entity
+{
+    // Uniqueness constraints are only available on iOS 9
+    if ( self.primaryKey == nil || ![entity respondsToSelector:@selector(uniquenessConstraints)] ) {
+        return NO;
+    }
+
+    for ( NSArray *constraint in entity.uniquenessConstraints ) {
+        // Each element is either a property name or a property description
+        id property = constraint.firstObject;
+        NSString *propertyName = [property isKindOfClass:[NSPropertyDescription class]] ? [property name] : property;
+        if ( constraint.count == 1 && [propertyName isEqualToString:self.primaryKey] ) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (RZVinylImportPlanEntry *)resolveEntryForExternalKey:(NSString *)key
+{
+    if ( [self.unplannedExternalKeys containsObject:key] ) {
+        return nil;
+    }
+
+    RZIPropertyInfo *propInfo = [self.moClass rzi_propertyInfoForExternalKey:key withMappings:self.mappings];
+    if ( propInfo.propertyName == nil ) {
+        return nil;
+    }
+
+    RZVinylImportPlanEntry *entry = [[RZVinylImportPlanEntry alloc] init];
+    entry.propertyName = propInfo.propertyName;
+
+    if ( propInfo.dataType == RZImportDataTypeOtherObject || propInfo.dataType == RZImportDataTypeNSSet ) {
+        entry.relationshipInfo = [RZVinylRelationshipInfo relationshipInfoForPropertyName:propInfo.propertyName ofClass:self.moClass inModel:self.model];
+    }
+
+    if ( entry.relationshipInfo == nil ) {
+        NSAttributeDescription *attribute = [self.attributesByName objectForKey:propInfo.propertyName];
+        if ( attribute == nil ) {
+            // Not a modeled property, so leave it to RZImport
+            return nil;
+        }
+        entry.attributeClass = NSClassFromString(attribute.attributeValueClassName);
+    }
+
+    return entry;
+}
+
+@end
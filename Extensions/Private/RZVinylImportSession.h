@@ -0,0 +1,87 @@
+//
+//  RZVinylImportSession.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@import CoreData;
+#import "NSManagedObjectContext+RZImport.h"
+
+/**
+ *  State shared by all of the nested imports performed inside a single call to
+ *  @p -[NSManagedObjectContext rzi_performImport:options:].
+ *  FOR INTERNAL LIBRARY USE ONLY
+ */
+@interface RZVinylImportSession : NSObject
+
+/**
+ *  The session for the current thread's import context, or nil if no import is in progress.
+ */
++ (RZVinylImportSession *)currentSession;
+
++ (void)setCurrentSession:(RZVinylImportSession *)session;
+
+- (instancetype)initWithOptions:(RZVinylImportOptions)options;
+
+@property (nonatomic, readonly, assign) RZVinylImportOptions options;
+
+/**
+ *  The import context's metrics collector, if it has one.
+ */
+@property (nonatomic, strong) RZVinylImportMetrics *metrics;
+
+/**
+ *  The number of array/dictionary imports currently on the stack for this session.
+ *  Zero means the next import is a top-level import.
+ */
+@property (nonatomic, assign) NSUInteger importDepth;
+
+- (BOOL)hasOptionsSet:(RZVinylImportOptions)options;
+
+/**
+ *  Whether the objects of the named entity were resolved up front by a prefetch.
+ *  If so, a missing entry means the object does not exist yet and no fetch is needed.
+ */
+- (BOOL)hasPrefetchedEntityNamed:(NSString *)entityName;
+
+/**
+ *  The prefetched or imported objects of the named entity, keyed by primary key value.
+ */
+- (NSDictionary *)objectsByPrimaryKeyValueForEntityNamed:(NSString *)entityName;
+
+- (NSManagedObject *)objectForPrimaryKeyValue:(id)primaryValue entityName:(NSString *)entityName;
+
+- (void)setObject:(NSManagedObject *)object forPrimaryKeyValue:(id)primaryValue entityName:(NSString *)entityName;
+
+- (void)addPrefetchedObjects:(NSDictionary *)objectsByPrimaryKeyValue forEntityName:(NSString *)entityName;
+
+/**
+ *  The number of distinct objects inserted or changed during the session.
+ */
+@property (nonatomic, readonly, assign) NSUInteger changedObjectCount;
+
+- (void)addChangedObject:(NSManagedObject *)object;
+
+@end
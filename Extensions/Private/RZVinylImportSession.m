@@ -0,0 +1,125 @@
+//
+//  RZVinylImportSession.m
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylImportSession.h"
+
+static NSString * const kRZVinylImportThreadSessionKey = @"RZVinylImportThreadSession";
+
+@interface RZVinylImportSession ()
+
+@property (nonatomic, readwrite, assign) RZVinylImportOptions options;
+@property (nonatomic, strong) NSMutableDictionary *objectsByEntityName;
+@property (nonatomic, strong) NSHashTable *changedObjects;
+
+@end
+
+@implementation RZVinylImportSession
+
++ (RZVinylImportSession *)currentSession
+{
+    return [[[NSThread currentThread] threadDictionary] objectForKey:kRZVinylImportThreadSessionKey];
+}
+
++ (void)setCurrentSession:(RZVinylImportSession *)session
+{
+    if ( session ) {
+        [[[NSThread currentThread] threadDictionary] setObject:session forKey:kRZVinylImportThreadSessionKey];
+    }
+    else {
+        [[[NSThread currentThread] threadDictionary] removeObjectForKey:kRZVinylImportThreadSessionKey];
+    }
+}
+
+- (instancetype)initWithOptions:(RZVinylImportOptions)options
+{
+    self = [super init];
+    if ( self ) {
+        _options = options;
+        _objectsByEntityName = [NSMutableDictionary dictionary];
+        _changedObjects = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    }
+    return self;
+}
+
+- (BOOL)hasOptionsSet:(RZVinylImportOptions)options
+{
+    return ( ( self.options & options ) == options );
+}
+
+- (BOOL)hasPrefetchedEntityNamed:(NSString *)entityName
+{
+    return ( entityName != nil && [self.objectsByEntityName objectForKey:entityName] != nil );
+}
+
+- (NSDictionary *)objectsByPrimaryKeyValueForEntityNamed:(NSString *)entityName
+{
+    return entityName ? [self.objectsByEntityName objectForKey:entityName] : nil;
+}
+
+- (NSManagedObject *)objectForPrimaryKeyValue:(id)primaryValue entityName:(NSString *)entityName
+{
+    if ( primaryValue == nil ) {
+        return nil;
+    }
+    return [[self objectsByPrimaryKeyValueForEntityNamed:entityName] objectForKey:primaryValue];
+}
+
+- (void)setObject:(NSManagedObject *)object forPrimaryKeyValue:(id)primaryValue entityName:(NSString *)entityName
+{
+    NSMutableDictionary *objectsByPrimaryKeyValue = [self.objectsByEntityName objectForKey:entityName];
+    if ( objectsByPrimaryKeyValue != nil && object != nil && primaryValue != nil ) {
+        [objectsByPrimaryKeyValue setObject:object forKey:primaryValue];
+    }
+}
+
+- (void)addPrefetchedObjects:(NSDictionary *)objectsByPrimaryKeyValue forEntityName:(NSString *)entityName
+{
+    if ( entityName == nil ) {
+        return;
+    }
+    NSMutableDictionary *existingObjects = [self.objectsByEntityName objectForKey:entityName];
+    if ( existingObjects == nil ) {
+        existingObjects = [NSMutableDictionary dictionary];
+        [self.objectsByEntityName setObject:existingObjects forKey:entityName];
+    }
+    [existingObjects addEntriesFromDictionary:objectsByPrimaryKeyValue];
+}
+
+- (NSUInteger)changedObjectCount
+{
+    return self.changedObjects.count;
+}
+
+- (void)addChangedObject:(NSManagedObject *)object
+{
+    if ( object != nil ) {
+        [self.changedObjects addObject:object];
+    }
+}
+
+@end
@@ -0,0 +1,54 @@
+//
+//  RZVinylJSONStreamReader.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@import Foundation;
+
+/**
+ *  Incrementally reads the elements of a top-level JSON array from an input stream,
+ *  deserializing one element at a time so that memory usage is independent of the size of the payload.
+ *  FOR INTERNAL LIBRARY USE ONLY
+ */
+@interface RZVinylJSONStreamReader : NSObject
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream;
+
+/**
+ *  Whether the closing bracket of the array has been read.
+ */
+@property (nonatomic, readonly, assign, getter=isAtEnd) BOOL atEnd;
+
+/**
+ *  Reads and deserializes up to @p maxCount elements from the stream, opening it if necessary.
+ *
+ *  @return The elements read, an empty array if the end of the JSON array has been reached, or nil if there was an error.
+ */
+- (NSArray *)nextElementsWithMaxCount:(NSUInteger)maxCount error:(NSError **)error;
+
+- (void)close;
+
+@end
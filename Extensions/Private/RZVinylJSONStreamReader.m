@@ -0,0 +1,281 @@
+//
+//  RZVinylJSONStreamReader.m
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylJSONStreamReader.h"
+#import "NSManagedObject+RZImport.h"
+
+static const NSUInteger kRZVinylJSONStreamBufferLength = 64 * 1024;
+
+typedef NS_ENUM(NSUInteger, RZVinylJSONStreamState) {
+    RZVinylJSONStreamStateBeforeArray = 0,
+    RZVinylJSONStreamStateBeforeElement,
+    RZVinylJSONStreamStateAfterComma,
+    RZVinylJSONStreamStateInElement,
+    RZVinylJSONStreamStateAfterElement,
+    RZVinylJSONStreamStateFinished
+};
+
+static inline BOOL RZVIsJSONWhitespace(uint8_t c)
+{
+    return ( c == ' ' || c == '\t' || c == '\n' || c == '\r' );
+}
+
+static inline BOOL RZVIsUTF8ByteOrderMark(uint8_t c)
+{
+    return ( c == 0xEF || c == 0xBB || c == 0xBF );
+}
+
+@interface RZVinylJSONStreamReader ()
+
+@property (nonatomic, strong) NSInputStream *stream;
+@property (nonatomic, strong) NSMutableData *elementData;
+
+@property (nonatomic, assign) RZVinylJSONStreamState state;
+@property (nonatomic, assign) NSUInteger depth;
+@property (nonatomic, assign) BOOL inString;
+@property (nonatomic, assign) BOOL escaped;
+
+@end
+
+@implementation RZVinylJSONStreamReader
+{
+    uint8_t _buffer[kRZVinylJSONStreamBufferLength];
+    NSUInteger _bufferLength;
+    NSUInteger _bufferOffset;
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream
+{
+    self = [super init];
+    if ( self ) {
+        _stream = stream;
+        _elementData = [NSMutableData data];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self close];
+}
+
+- (BOOL)isAtEnd
+{
+    return ( self.state == RZVinylJSONStreamStateFinished );
+}
+
+- (void)close
+{
+    if ( self.stream.streamStatus != NSStreamStatusNotOpen && self.stream.streamStatus != NSStreamStatusClosed ) {
+        [self.stream close];
+    }
+}
+
+- (NSArray *)nextElementsWithMaxCount:(NSUInteger)maxCount error:(NSError *__autoreleasing *)error
+{
+    NSMutableArray *elements = [NSMutableArray array];
+    NSError *readErr = nil;
+
+    if ( self.stream.streamStatus == NSStreamStatusNotOpen ) {
+        [self.stream open];
+    }
+
+    while ( elements.count < maxCount && self.state != RZVinylJSONStreamStateFinished ) {
+        if ( _bufferOffset >= _bufferLength && ![self fillBuffer:&readErr] ) {
+            break;
+        }
+
+        uint8_t c = _buffer[_bufferOffset];
+        BOOL consumed = YES;
+
+        switch ( self.state ) {
+            case RZVinylJSONStreamStateBeforeArray:
+                if ( c == '[' ) {
+                    self.state = RZVinylJSONStreamStateBeforeElement;
+                }
+                else if ( !RZVIsJSONWhitespace(c) && !RZVIsUTF8ByteOrderMark(c) ) {
+                    readErr = [self invalidJSONError:@"Expected a JSON array"];
+                }
+                break;
+
+            case RZVinylJSONStreamStateBeforeElement:
+            case RZVinylJSONStreamStateAfterComma:
+                if ( c == ']' ) {
+                    if ( self.state == RZVinylJSONStreamStateAfterComma ) {
+                        readErr = [self invalidJSONError:@"Expected an array element after ','"];
+                    }
+                    else {
+                        self.state = RZVinylJSONStreamStateFinished;
+                    }
+                }
+                else if ( !RZVIsJSONWhitespace(c) ) {
+                    self.state = RZVinylJSONStreamStateInElement;
+                    self.depth = 0;
+                    self.inString = NO;
+                    self.escaped = NO;
+                    consumed = NO;
+                }
+                break;
+
+            case RZVinylJSONStreamStateInElement: {
+                id element = nil;
+                consumed = [self appendElementByte:c element:&element error:&readErr];
+                if ( element != nil ) {
+                    [elements addObject:element];
+                    self.state = RZVinylJSONStreamStateAfterElement;
+                }
+            }
+                break;
+
+            case RZVinylJSONStreamStateAfterElement:
+                if ( c == ',' ) {
+                    self.state = RZVinylJSONStreamStateAfterComma;
+                }
+                else if ( c == ']' ) {
+                    self.state = RZVinylJSONStreamStateFinished;
+                }
+                else if ( !RZVIsJSONWhitespace(c) ) {
+                    readErr = [self invalidJSONError:@"Expected ',' or ']' after array element"];
+                }
+                break;
+
+            case RZVinylJSONStreamStateFinished:
+                break;
+        }
+
+        if ( readErr != nil ) {
+            break;
+        }
+
+        if ( consumed ) {
+            _bufferOffset++;
+        }
+    }
+
+    if ( readErr != nil ) {
+        if ( error != NULL ) {
+            *error = readErr;
+        }
+        return nil;
+    }
+
+    return elements;
+}
+
+#pragma mark - Private
+
+/**
+ *  Appends a byte to the element currently being read, deserializing the element when it is complete.
+ *
+ *  @return NO if the byte terminated a scalar element and was not consumed, YES otherwise.
+ */
+- (BOOL)appendElementByte:(uint8_t)c element:(id *)element error:(NSError *__autoreleasing *)error
+{
+    BOOL consumed = YES;
+    BOOL complete = NO;
+
+    if ( self.inString ) {
+        [self.elementData appendBytes:&c length:1];
+        if ( self.escaped ) {
+            self.escaped = NO;
+        }
+        else if ( c == '\\' ) {
+            self.escaped = YES;
+        }
+        else if ( c == '"' ) {
+            self.inString = NO;
+            complete = ( self.depth == 0 );
+        }
+    }
+    else if ( self.depth == 0 && self.elementData.length > 0 ) {
+        // Number or literal element, which ends at the next delimiter
+        if ( c == ',' || c == ']' || RZVIsJSONWhitespace(c) ) {
+            consumed = NO;
+            complete = YES;
+        }
+        else {
+            [self.elementData appendBytes:&c length:1];
+        }
+    }
+    else {
+        [self.elementData appendBytes:&c length:1];
+        if ( c == '"' ) {
+            self.inString = YES;
+        }
+        else if ( c == '{' || c == '[' ) {
+            self.depth++;
+        }
+        else if ( c == '}' || c == ']' ) {
+            if ( self.depth == 0 ) {
+                *error = [self invalidJSONError:@"Unbalanced brackets in array element"];
+                return YES;
+            }
+            self.depth--;
+            complete = ( self.depth == 0 );
+        }
+    }
+
+    if ( complete ) {
+        NSError *parseErr = nil;
+        *element = [NSJSONSerialization JSONObjectWithData:self.elementData options:NSJSONReadingAllowFragments error:&parseErr];
+        if ( *element == nil ) {
+            *error = parseErr;
+        }
+        [self.elementData setLength:0];
+    }
+
+    return consumed;
+}
+
+- (BOOL)fillBuffer:(NSError *__autoreleasing *)error
+{
+    NSInteger bytesRead = [self.stream read:_buffer maxLength:kRZVinylJSONStreamBufferLength];
+    if ( bytesRead < 0 ) {
+        *error = self.stream.streamError ?: [self invalidJSONError:@"Unable to read from JSON stream"];
+        return NO;
+    }
+
+    if ( bytesRead == 0 ) {
+        // The stream should never end before the closing bracket of the array
+        *error = [self invalidJSONError:@"Unexpected end of JSON stream"];
+        return NO;
+    }
+
+    _bufferLength = (NSUInteger)bytesRead;
+    _bufferOffset = 0;
+    return YES;
+}
+
+- (NSError *)invalidJSONError:(NSString *)reason
+{
+    return [NSError errorWithDomain:RZVinylImportErrorDomain
+                               code:RZVinylImportErrorInvalidJSON
+                           userInfo:@{ NSLocalizedDescriptionKey : reason }];
+}
+
+@end
@@ -45,4 +45,19 @@
 
 + (RZVinylRelationshipInfo *)relationshipInfoFromDescription:(NSRelationshipDescription *)description;
 
+/**
+ *  Return the relationship info for the named relationship of a managed object class, or nil
+ *  if the property is not a relationship.
+ *
+ *  The relationship table for every entity class in a model is built once per model, on first access,
+ *  and released with the model. Import plans keep the info for each key, so this is only called when a plan is built.
+ *
+ *  @param propertyName The name of the relationship property.
+ *  @param moClass      The managed object class declaring the relationship.
+ *  @param model        The model declaring the class's entity.
+ */
++ (RZVinylRelationshipInfo *)relationshipInfoForPropertyName:(NSString *)propertyName
+                                                     ofClass:(Class)moClass
+                                                     inModel:(NSManagedObjectModel *)model;
+
 @end
\ No newline at end of file
@@ -57,5 +57,68 @@
     return info;
 }
 
++ (RZVinylRelationshipInfo *)relationshipInfoForPropertyName:(NSString *)propertyName
+                                                     ofClass:(Class)moClass
+                                                     inModel:(NSManagedObjectModel *)model
+{
+    if ( propertyName == nil || moClass == Nil || model == nil ) {
+        return nil;
+    }
+
+    NSDictionary *classRelationships = [[self relationshipTableForModel:model] objectForKey:NSStringFromClass(moClass)];
+    return [classRelationships objectForKey:propertyName];
+}
+
+#pragma mark - Private
+
+/**
+ *  The table of class name -> (relationship name -> info) for the model, built on first access and released
+ *  with the model. The table covers every entity class in the model, so a class that is missing from it is
+ *  not an entity class and never causes a rebuild.
+ *  Only import plan compilation reads the table, so the lock is never taken on the per-object import path.
+ */
++ (NSDictionary *)relationshipTableForModel:(NSManagedObjectModel *)model
+{
+    static NSMapTable *s_relationshipTablesByModel = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        s_relationshipTablesByModel = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                                valueOptions:NSPointerFunctionsStrongMemory
+                                                                    capacity:0];
+    });
+
+    @synchronized ( s_relationshipTablesByModel ) {
+        NSDictionary *relationshipTable = [s_relationshipTablesByModel objectForKey:model];
+        if ( relationshipTable == nil ) {
+            relationshipTable = [self buildRelationshipTableForModel:model];
+            [s_relationshipTablesByModel setObject:relationshipTable forKey:model];
+        }
+        return relationshipTable;
+    }
+}
+
++ (NSDictionary *)buildRelationshipTableForModel:(NSManagedObjectModel *)model
+{
+    NSMutableDictionary *relationshipTable = [NSMutableDictionary dictionary];
+    for ( NSEntityDescription *entity in model.entities ) {
+        NSString *className = entity.managedObjectClassName;
+        if ( className == nil || [className isEqualToString:NSStringFromClass([NSManagedObject class])] ) {
+            continue;
+        }
+
+        // If several entities share a class, the first one wins
+        if ( [relationshipTable objectForKey:className] != nil ) {
+            continue;
+        }
+
+        NSMutableDictionary *classRelationships = [NSMutableDictionary dictionary];
+        [entity.relationshipsByName enumerateKeysAndObjectsUsingBlock:^(NSString *name, NSRelationshipDescription *description, BOOL *stop) {
+            [classRelationships setObject:[self relationshipInfoFromDescription:description] forKey:name];
+        }];
+        [relationshipTable setObject:[NSDictionary dictionaryWithDictionary:classRelationships] forKey:className];
+    }
+    return [NSDictionary dictionaryWithDictionary:relationshipTable];
+}
+
 
 @end
\ No newline at end of file
@@ -0,0 +1,121 @@
+//
+//  RZVinylImportMetrics.h
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@import CoreData;
+#import "RZVCompatibility.h"
+
+@class RZVinylImportMetrics;
+@class RZVinylImportReport;
+
+/**
+ *  What an import did to the objects of a single entity.
+ */
+@interface RZVinylImportEntityMetrics : NSObject <NSCopying>
+
+@property (nonatomic, readonly, copy) NSString *entityName;
+
+/**
+ *  The number of fetches performed to find existing objects.
+ */
+@property (nonatomic, readonly, assign) NSUInteger prefetchQueryCount;
+
+/**
+ *  The number of existing objects found in the context's identity map, without a fetch.
+ */
+@property (nonatomic, readonly, assign) NSUInteger identityMapHitCount;
+
+/**
+ *  The number of records imported into new objects.
+ */
+@property (nonatomic, readonly, assign) NSUInteger insertCount;
+
+/**
+ *  The number of records that changed an existing object.
+ */
+@property (nonatomic, readonly, assign) NSUInteger updateCount;
+
+/**
+ *  The number of records that left an existing object unchanged.
+ */
+@property (nonatomic, readonly, assign) NSUInteger unchangedCount;
+
+/**
+ *  The number of relationships imported from nested values.
+ */
+@property (nonatomic, readonly, assign) NSUInteger relationshipImportCount;
+
+/**
+ *  The time spent importing objects of the entity, not including time spent in nested imports of other entities.
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval duration;
+
+@end
+
+/**
+ *  The metrics of a single call to @p -[NSManagedObjectContext rzi_performImport:], per entity.
+ */
+@interface RZVinylImportReport : NSObject
+
+/**
+ *  The metrics for each entity that was imported, keyed by entity name.
+ */
+@property (nonatomic, readonly, copy) RZGeneric(NSDictionary, NSString *, RZVinylImportEntityMetrics *) *entityMetrics;
+
+/**
+ *  The total time spent in the import.
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval duration;
+
+@end
+
+@protocol RZVinylImportMetricsDelegate <NSObject>
+
+/**
+ *  Called on the import context's queue at the end of each call to @p -[NSManagedObjectContext rzi_performImport:].
+ */
+- (void)importMetrics:(RZVinylImportMetrics* RZCNonnull)metrics didFinishImportWithReport:(RZVinylImportReport* RZCNonnull)report;
+
+@end
+
+/**
+ *  An opt-in collector of import metrics. Attach an instance to a context with
+ *  @p -[NSManagedObjectContext rzi_setImportMetrics:], and every import into that context will produce a report.
+ *
+ *  @note Collecting metrics adds a small amount of overhead to every imported record, so it should not be left
+ *        attached to contexts that import large payloads unless the metrics are needed.
+ */
+@interface RZVinylImportMetrics : NSObject
+
+@property (nonatomic, weak) id<RZVinylImportMetricsDelegate> RZCNullable delegate;
+
+/**
+ *  The report of the most recently finished import, or nil if no import has finished.
+ */
+@property (nonatomic, readonly, strong) RZVinylImportReport* RZCNullable lastReport;
+
+@end
@@ -0,0 +1,223 @@
+//
+//  RZVinylImportMetrics.m
+//  RZVinyl
+//
+//  Created by RZVinyl Contributors on 10/17/26.
+//
+//  Copyright 2014 Raizlabs and other contributors
+//  http://raizlabs.com/
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+//  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+//  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "RZVinylImportMetrics.h"
+#import "RZVinylImportMetrics_private.h"
+
+@interface RZVinylImportEntityMetrics ()
+
+@property (nonatomic, readwrite, copy) NSString *entityName;
+@property (nonatomic, readwrite, assign) NSUInteger prefetchQueryCount;
+@property (nonatomic, readwrite, assign) NSUInteger identityMapHitCount;
+@property (nonatomic, readwrite, assign) NSUInteger insertCount;
+@property (nonatomic, readwrite, assign) NSUInteger updateCount;
+@property (nonatomic, readwrite, assign) NSUInteger unchangedCount;
+@property (nonatomic, readwrite, assign) NSUInteger relationshipImportCount;
+@property (nonatomic, readwrite, assign) NSTimeInterval duration;
+
+@end
+
+@implementation RZVinylImportEntityMetrics
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    RZVinylImportEntityMetrics *copy = [[[self class] allocWithZone:zone] init];
+    copy.entityName                 = self.entityName;
+    copy.prefetchQueryCount         = self.prefetchQueryCount;
+    copy.identityMapHitCount        = self.identityMapHitCount;
+    copy.insertCount                = self.insertCount;
+    copy.updateCount                = self.updateCount;
+    copy.unchangedCount             = self.unchangedCount;
+    copy.relationshipImportCount    = self.relationshipImportCount;
+    copy.duration                   = self.duration;
+    return copy;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@: %lu queries, %lu identity map hits, %lu inserted, %lu updated, %lu unchanged, %lu relationships, %.4f s",
+            self.entityName,
+            (unsigned long)self.prefetchQueryCount,
+            (unsigned long)self.identityMapHitCount,
+            (unsigned long)self.insertCount,
+            (unsigned long)self.updateCount,
+            (unsigned long)self.unchangedCount,
+            (unsigned long)self.relationshipImportCount,
+            self.duration];
+}
+
+@end
+
+@interface RZVinylImportReport ()
+
+@property (nonatomic, readwrite, copy) NSDictionary *entityMetrics;
+@property (nonatomic, readwrite, assign) NSTimeInterval duration;
+
+@end
+
+@implementation RZVinylImportReport
+
+- (NSString *)description
+{
+    NSMutableString *description = [NSMutableString stringWithFormat:@"<%@: %p> Import took %.4f s", NSStringFromClass([self class]), self, self.duration];
+    for ( NSString *entityName in [[self.entityMetrics allKeys] sortedArrayUsingSelector:@selector(compare:)] ) {
+        [description appendFormat:@"\n  %@", [self.entityMetrics objectForKey:entityName]];
+    }
+    return description;
+}
+
+@end
+
+/**
+ *  A nested entity import being timed.
+ */
+@interface RZVinylImportMetricsFrame : NSObject
+
+@property (nonatomic, copy) NSString *entityName;
+@property (nonatomic, assign) CFAbsoluteTime startTime;
+@property (nonatomic, assign) CFAbsoluteTime nestedDuration;
+
+@end
+
+@implementation RZVinylImportMetricsFrame
+
+@end
+
+@interface RZVinylImportMetrics ()
+
+@property (nonatomic, readwrite, strong) RZVinylImportReport *lastReport;
+
+@property (nonatomic, strong) NSMutableDictionary *entityMetrics;
+@property (nonatomic, strong) NSMutableArray *frames;
+@property (nonatomic, assign) CFAbsoluteTime importStartTime;
+
+@end
+
+@implementation RZVinylImportMetrics
+
+- (instancetype)init
+{
+    self = [super init];
+    if ( self ) {
+        _entityMetrics = [NSMutableDictionary dictionary];
+        _frames = [NSMutableArray array];
+    }
+    return self;
+}
+
+#pragma mark - Recording
+
+- (void)beginImport
+{
+    [self.entityMetrics removeAllObjects];
+    [self.frames removeAllObjects];
+    self.importStartTime = CFAbsoluteTimeGetCurrent();
+}
+
+- (RZVinylImportReport *)finishImport
+{
+    RZVinylImportReport *report = [[RZVinylImportReport alloc] init];
+    report.duration = CFAbsoluteTimeGetCurrent() - self.importStartTime;
+
+    NSMutableDictionary *entityMetrics = [NSMutableDictionary dictionaryWithCapacity:self.entityMetrics.count];
+    [self.entityMetrics enumerateKeysAndObjectsUsingBlock:^(NSString *entityName, RZVinylImportEntityMetrics *metrics, BOOL *stop) {
+        [entityMetrics setObject:[metrics copy] forKey:entityName];
+    }];
+    report.entityMetrics = entityMetrics;
+
+    self.lastReport = report;
+    [self.delegate importMetrics:self didFinishImportWithReport:report];
+    return report;
+}
+
+- (void)beginImportOfEntityNamed:(NSString *)entityName
+{
+    RZVinylImportMetricsFrame *frame = [[RZVinylImportMetricsFrame alloc] init];
+    frame.entityName = entityName;
+    frame.startTime = CFAbsoluteTimeGetCurrent();
+    [self.frames addObject:frame];
+}
+
+- (void)endImportOfEntityNamed:(NSString *)entityName
+{
+    RZVinylImportMetricsFrame *frame = [self.frames lastObject];
+    if ( frame == nil || ![frame.entityName isEqualToString:entityName] ) {
+        return;
+    }
+    [self.frames removeLastObject];
+
+    CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - frame.startTime;
+    [self metricsForEntityNamed:entityName].duration += ( elapsed - frame.nestedDuration );
+
+    RZVinylImportMetricsFrame *parentFrame = [self.frames lastObject];
+    parentFrame.nestedDuration += elapsed;
+}
+
+- (void)recordPrefetchQueries:(NSUInteger)queryCount identityMapHits:(NSUInteger)hitCount forEntityNamed:(NSString *)entityName
+{
+    RZVinylImportEntityMetrics *metrics = [self metricsForEntityNamed:entityName];
+    metrics.prefetchQueryCount += queryCount;
+    metrics.identityMapHitCount += hitCount;
+}
+
+- (void)recordResult:(RZVinylImportRecordResult)result forEntityNamed:(NSString *)entityName
+{
+    RZVinylImportEntityMetrics *metrics = [self metricsForEntityNamed:entityName];
+    switch ( result ) {
+        case RZVinylImportRecordResultInserted:
+            metrics.insertCount += 1;
+            break;
+        case RZVinylImportRecordResultUpdated:
+            metrics.updateCount += 1;
+            break;
+        case RZVinylImportRecordResultUnchanged:
+            metrics.unchangedCount += 1;
+            break;
+    }
+}
+
+- (void)recordRelationshipImportForEntityNamed:(NSString *)entityName
+{
+    [self metricsForEntityNamed:entityName].relationshipImportCount += 1;
+}
+
+#pragma mark - Private
+
+- (RZVinylImportEntityMetrics *)metricsForEntityNamed:(NSString *)entityName
+{
+    NSString *key = entityName ?: @"";
+    RZVinylImportEntityMetrics *metrics = [self.entityMetrics objectForKey:key];
+    if ( metrics == nil ) {
+        metrics = [[RZVinylImportEntityMetrics alloc] init];
+        metrics.entityName = key;
+        [self.entityMetrics setObject:metrics forKey:key];
+    }
+    return metrics;
+}
+
+@end